@@ -0,0 +1,188 @@
+#pragma once
+
+// Monotonic arena (bump allocator) with a std::pmr adapter
+//
+// basic_concepts_iv allocates with `new int[3]`, leaks `new int{10}` and
+// loses track of several `new int{3}`. When a whole batch of objects dies
+// together (everything allocated while serving one request), none of them
+// needs its own `delete`:
+//   - `Arena` hands out memory by bumping a pointer through large chunks;
+//     `deallocate` doesn't exist, so an allocation is an add and a compare
+//   - when a chunk runs out, the next one is twice as large (from
+//     `initial_chunk_size` up to `max_chunk_size`), or bigger if a single
+//     request needs it
+//   - `reset()` rewinds to the first chunk but keeps every chunk, so the
+//     next batch allocates without touching `operator new` at all;
+//     `release()` returns the chunks (as does the destructor)
+//   - `ArenaResource` adapts an `Arena` to `std::pmr::memory_resource`, so
+//     `std::pmr::vector`, `std::pmr::string`, `std::pmr::map`, ... allocate
+//     from it (their deallocations become no-ops)
+//
+// Destructors of objects in the arena are not run by `reset()`; use it for
+// trivially destructible data, or containers that have already been
+// destroyed. Not thread-safe: one arena per thread or per request.
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace arena {
+
+inline constexpr std::size_t initial_chunk_size = std::size_t{64} << 10;
+inline constexpr std::size_t max_chunk_size = std::size_t{16} << 20;
+
+class Arena {
+  public:
+    explicit Arena(std::size_t first_chunk_size = initial_chunk_size)
+        : next_chunk_size_{std::max<std::size_t>(first_chunk_size, 64)} {}
+
+    Arena(const Arena &) = delete;
+    auto operator=(const Arena &) -> Arena & = delete;
+    Arena(Arena &&) = delete;
+    auto operator=(Arena &&) -> Arena & = delete;
+
+    ~Arena() { release(); }
+
+    // `size` bytes aligned to `alignment` (a power of two, else
+    // `std::invalid_argument`); `std::bad_alloc` if a chunk can't be allocated
+    [[nodiscard]] auto allocate(std::size_t size,
+                                std::size_t alignment = alignof(
+                                    std::max_align_t)) -> void * {
+        if (!std::has_single_bit(alignment)) {
+            throw std::invalid_argument{"arena: alignment not a power of 2"};
+        }
+        auto aligned = (pos_ + alignment - 1) & ~(alignment - 1);
+        if (end_ == 0 || aligned > end_ || size > end_ - aligned) {
+            next_chunk(size, alignment);
+            aligned = (pos_ + alignment - 1) & ~(alignment - 1);
+        }
+        pos_ = aligned + size;
+        used_ += size;
+        // NOLINTNEXTLINE(performance-no-int-to-ptr)
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    // A `T` constructed in the arena (never destroyed by the arena)
+    template <typename T, typename... Args>
+    auto make(Args &&...args) -> T * {
+        return std::construct_at(static_cast<T *>(allocate(sizeof(T),
+                                                           alignof(T))),
+                                 std::forward<Args>(args)...);
+    }
+
+    // Uninitialized storage for `count` `T`s
+    template <typename T>
+    [[nodiscard]] auto allocate_array(std::size_t count) -> T * {
+        if (count > SIZE_MAX / sizeof(T)) {
+            throw std::bad_array_new_length{};
+        }
+        return static_cast<T *>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // Forget every allocation, keep the chunks for reuse
+    void reset() {
+        current_ = 0;
+        pos_ = end_ = 0;
+        if (!chunks_.empty()) {
+            enter(0);
+        }
+        used_ = 0;
+    }
+
+    // Forget every allocation and free the chunks
+    void release() {
+        for (const auto &c : chunks_) {
+            ::operator delete(c.memory, c.size, chunk_alignment);
+        }
+        chunks_.clear();
+        current_ = 0;
+        pos_ = end_ = 0;
+        used_ = 0;
+    }
+
+    // Bytes handed out since the last reset (excluding alignment padding)
+    [[nodiscard]] auto bytes_used() const -> std::size_t { return used_; }
+    // Bytes held in chunks
+    [[nodiscard]] auto bytes_reserved() const -> std::size_t {
+        std::size_t total = 0;
+        for (const auto &c : chunks_) {
+            total += c.size;
+        }
+        return total;
+    }
+    [[nodiscard]] auto num_chunks() const -> std::size_t {
+        return chunks_.size();
+    }
+
+  private:
+    static constexpr std::align_val_t chunk_alignment{
+        alignof(std::max_align_t)};
+
+    struct Chunk {
+        void *memory;
+        std::size_t size;
+    };
+
+    void enter(std::size_t index) {
+        current_ = index;
+        pos_ = reinterpret_cast<std::uintptr_t>(chunks_[index].memory);
+        end_ = pos_ + chunks_[index].size;
+    }
+
+    // Move to the first following chunk that fits, or allocate one
+    void next_chunk(std::size_t size, std::size_t alignment) {
+        if (size > SIZE_MAX - alignment) {
+            throw std::bad_alloc{};
+        }
+        auto needed = size + alignment;
+        for (auto i = chunks_.empty() ? 0 : current_ + 1; i < chunks_.size();
+             i++) {
+            if (chunks_[i].size >= needed) {
+                // skipped chunks stay unused until the next reset
+                enter(i);
+                return;
+            }
+        }
+        auto chunk_size = std::max(next_chunk_size_, needed);
+        next_chunk_size_ = std::min(next_chunk_size_ * 2, max_chunk_size);
+        chunks_.push_back(
+            {::operator new(chunk_size, chunk_alignment), chunk_size});
+        enter(chunks_.size() - 1);
+    }
+
+    std::vector<Chunk> chunks_;
+    std::size_t current_ = 0;
+    std::uintptr_t pos_ = 0;
+    std::uintptr_t end_ = 0;
+    std::size_t used_ = 0;
+    std::size_t next_chunk_size_;
+};
+
+// `std::pmr::memory_resource` view of an `Arena`
+class ArenaResource : public std::pmr::memory_resource {
+  public:
+    explicit ArenaResource(Arena &arena) : arena_{&arena} {}
+
+  private:
+    auto do_allocate(std::size_t bytes, std::size_t alignment)
+        -> void * override {
+        return arena_->allocate(bytes, alignment);
+    }
+    void do_deallocate(void * /*p*/, std::size_t /*bytes*/,
+                       std::size_t /*alignment*/) override {}
+    [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource &other)
+        const noexcept -> bool override {
+        return this == &other;
+    }
+
+    Arena *arena_;
+};
+
+} // namespace arena
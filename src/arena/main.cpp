@@ -0,0 +1,165 @@
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory_resource>
+#include <print>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "arena/arena.hpp"
+#include "bench/bench.hpp"
+
+using namespace std;
+
+#define PRINT_VAR(var) std::println("{} = {}", #var, var);
+
+constexpr size_t num_requests = 100;
+constexpr size_t strings_per_request = 10'000;
+constexpr size_t inserts_per_request = 10'000;
+constexpr int reps = 5;
+
+// One request: copy `inputs` into a vector of strings, sum their lengths,
+// drop it
+template <typename Vector>
+auto strings_request(Vector &&texts, const vector<string> &inputs)
+    -> uint64_t {
+    for (const auto &input : inputs) {
+        texts.emplace_back(input.data(), input.size());
+    }
+    uint64_t total = 0;
+    for (const auto &text : texts) {
+        total += text.size();
+    }
+    return total;
+}
+
+// One request: insert keys into a map, sum the values, drop it
+template <typename Map>
+auto map_request(Map &&index, const vector<uint32_t> &keys) -> uint64_t {
+    for (auto key : keys) {
+        index[key] += key;
+    }
+    uint64_t total = 0;
+    for (const auto &[key, value] : index) {
+        total += value;
+    }
+    return total;
+}
+
+// `run()` once per request; the arena variants reset between requests,
+// where a server would
+template <typename F>
+void bench_requests(const char *label, size_t items_per_request,
+                    const char *unit, F &&run) {
+    uint64_t total = 0;
+    auto t = bench::time_best(reps, [&] {
+        total = 0;
+        for (size_t r = 0; r < num_requests; r++) {
+            total += run();
+        }
+    });
+    bench::report(label, t,
+                  static_cast<double>(num_requests * items_per_request), unit);
+    bench::do_not_optimize(total);
+}
+
+auto main() -> int {
+    println("Arena - bump allocation with reset between requests");
+
+    // basic_concepts_iv: `new int[3]`, a leaked `new int{10}` and several
+    // `new int{3}` each need their own `delete`; in an arena none do
+    {
+        arena::Arena scratch{4096};
+        auto *ints = scratch.allocate_array<int>(3);
+        ints[0] = 1;
+        ints[1] = 2;
+        ints[2] = 3;
+        auto *ml = scratch.make<int>(10);
+        for (int i = 0; i < 3; i++) {
+            bench::do_not_optimize(scratch.make<int>(3));
+        }
+        auto *aligned = scratch.allocate(64, 64);
+        PRINT_VAR(ints[2])
+        PRINT_VAR(*ml)
+        PRINT_VAR(reinterpret_cast<uintptr_t>(aligned) % 64)
+        PRINT_VAR(scratch.bytes_used())
+        PRINT_VAR(scratch.num_chunks())
+        // everything is freed here, with the arena
+    }
+    // Longer than any small-string buffer, so every copy allocates
+    vector<string> inputs(strings_per_request);
+    for (size_t i = 0; i < inputs.size(); i++) {
+        inputs[i] = "request-scoped payload #" + to_string(i) + " ........";
+    }
+    {
+        arena::Arena growing{1024};
+        arena::ArenaResource resource{growing};
+        pmr::vector<pmr::string> texts{&resource};
+        strings_request(texts, inputs);
+        PRINT_VAR(texts.size())
+        PRINT_VAR(growing.num_chunks())
+        PRINT_VAR(growing.bytes_reserved())
+        texts = pmr::vector<pmr::string>{&resource};
+        growing.reset();
+        PRINT_VAR(growing.bytes_used())
+        PRINT_VAR(growing.num_chunks())
+    }
+
+    println("\nvector of {} strings, {} requests:", strings_per_request,
+            num_requests);
+    auto strings = [&](const char *label, auto &&run) {
+        bench_requests(label, strings_per_request, "strings", run);
+    };
+    strings("std::vector<std::string>",
+            [&] { return strings_request(vector<string>{}, inputs); });
+    pmr::unsynchronized_pool_resource pool;
+    strings("pmr unsynchronized_pool_resource", [&] {
+        return strings_request(pmr::vector<pmr::string>{&pool}, inputs);
+    });
+    strings("pmr monotonic_buffer_resource", [&] {
+        pmr::monotonic_buffer_resource monotonic;
+        return strings_request(pmr::vector<pmr::string>{&monotonic}, inputs);
+    });
+    arena::Arena strings_arena;
+    arena::ArenaResource strings_resource{strings_arena};
+    strings("Arena (reset per request)", [&] {
+        auto total = strings_request(
+            pmr::vector<pmr::string>{&strings_resource}, inputs);
+        strings_arena.reset();
+        return total;
+    });
+
+    mt19937 rng{22};
+    vector<uint32_t> keys(inserts_per_request);
+    for (auto &key : keys) {
+        key = static_cast<uint32_t>(rng());
+    }
+    println("\nmap with {} random inserts, {} requests:", inserts_per_request,
+            num_requests);
+    auto inserts = [&](const char *label, auto &&run) {
+        bench_requests(label, inserts_per_request, "inserts", run);
+    };
+    auto expected = map_request(map<uint32_t, uint64_t>{}, keys);
+    inserts("std::map",
+            [&] { return map_request(map<uint32_t, uint64_t>{}, keys); });
+    inserts("pmr unsynchronized_pool_resource", [&] {
+        return map_request(pmr::map<uint32_t, uint64_t>{&pool}, keys);
+    });
+    inserts("pmr monotonic_buffer_resource", [&] {
+        pmr::monotonic_buffer_resource monotonic;
+        return map_request(pmr::map<uint32_t, uint64_t>{&monotonic}, keys);
+    });
+    arena::Arena map_arena;
+    arena::ArenaResource map_resource{map_arena};
+    uint64_t arena_total = 0;
+    inserts("Arena (reset per request)", [&] {
+        arena_total =
+            map_request(pmr::map<uint32_t, uint64_t>{&map_resource}, keys);
+        map_arena.reset();
+        return arena_total;
+    });
+    println("  results match: {}", arena_total == expected);
+    println("  arena chunks: {} ({} KiB)", map_arena.num_chunks(),
+            map_arena.bytes_reserved() >> 10);
+}
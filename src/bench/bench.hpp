@@ -0,0 +1,65 @@
+#pragma once
+
+// Tiny timing helpers shared by the `*_bench` executables
+// - not a replacement for google/benchmark; just enough to compare approaches
+// - only meaningful in a Release build: `just build-release <target>`
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <print>
+#include <string_view>
+
+namespace bench {
+
+// Make the compiler assume `value` is read, so the work producing it can't be
+// optimized away (GNU inline asm - gcc and clang)
+template <typename T> //
+inline void do_not_optimize(T const &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Make the compiler assume all memory may have been read or written
+inline void clobber_memory() { asm volatile("" : : : "memory"); }
+
+// Best wall time (in seconds) of `reps` calls to `fn`
+// - best-of rather than mean: noise (other processes, frequency scaling) only
+//   ever makes a run slower
+template <typename F> //
+auto time_best(int reps, F &&fn) -> double {
+    double best = std::numeric_limits<double>::max();
+    for (int r = 0; r < reps; r++) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto stop = std::chrono::steady_clock::now();
+        best = std::min(best,
+                        std::chrono::duration<double>(stop - start).count());
+    }
+    return best;
+}
+
+// Same, but calls `setup()` untimed before each rep (ex. to re-shuffle the
+// input of an in-place sort)
+template <typename Setup, typename F> //
+auto time_best(int reps, Setup &&setup, F &&fn) -> double {
+    double best = std::numeric_limits<double>::max();
+    for (int r = 0; r < reps; r++) {
+        setup();
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto stop = std::chrono::steady_clock::now();
+        best = std::min(best,
+                        std::chrono::duration<double>(stop - start).count());
+    }
+    return best;
+}
+
+// "<name>  <rate> M<unit>/s  (<ms> ms)"
+inline void report(std::string_view name, double seconds, double items,
+                   std::string_view unit = "items") {
+    std::println("  {:<36} {:>10.2f} M{}/s  ({:.2f} ms)", name,
+                 items / seconds / 1e6, unit, seconds * 1e3);
+}
+
+} // namespace bench
@@ -0,0 +1,103 @@
+#pragma once
+
+// Hardware event counts around a piece of a benchmark (Linux perf events)
+// - counts this thread in user space only, like `perf stat -e <event>:u`
+// - `available()` is false where the kernel has no counters to give (other
+//   OSes, VMs without a virtual PMU, `perf_event_paranoid` > 2, seccomp);
+//   counts are then 0 and benchmarks should print them as unavailable
+
+#include <cstdint>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench {
+
+enum class Event : std::uint8_t {
+    cycles,
+    instructions,
+    branches,
+    branch_misses,
+    cache_misses
+};
+
+class PerfCounter {
+  public:
+    explicit PerfCounter(Event event) {
+#if defined(__linux__)
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config(event);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(
+            syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+        (void)event;
+#endif
+    }
+
+    PerfCounter(const PerfCounter &) = delete;
+    auto operator=(const PerfCounter &) -> PerfCounter & = delete;
+
+    ~PerfCounter() {
+#if defined(__linux__)
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+#endif
+    }
+
+    [[nodiscard]] auto available() const -> bool { return fd_ >= 0; }
+
+    // Events counted during `fn()`
+    template <typename F> auto count(F &&fn) -> std::uint64_t {
+        if (!available()) {
+            std::forward<F>(fn)();
+            return 0;
+        }
+#if defined(__linux__)
+        ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        std::forward<F>(fn)();
+        ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+        std::uint64_t value = 0;
+        if (read(fd_, &value, sizeof(value)) != sizeof(value)) {
+            return 0;
+        }
+        return value;
+#else
+        return 0;
+#endif
+    }
+
+  private:
+#if defined(__linux__)
+    static auto config(Event event) -> std::uint64_t {
+        switch (event) {
+        case Event::cycles:
+            return PERF_COUNT_HW_CPU_CYCLES;
+        case Event::instructions:
+            return PERF_COUNT_HW_INSTRUCTIONS;
+        case Event::branches:
+            return PERF_COUNT_HW_BRANCH_INSTRUCTIONS;
+        case Event::branch_misses:
+            return PERF_COUNT_HW_BRANCH_MISSES;
+        case Event::cache_misses:
+            return PERF_COUNT_HW_CACHE_MISSES;
+        }
+        return PERF_COUNT_HW_CPU_CYCLES;
+    }
+#endif
+
+    int fd_ = -1;
+};
+
+} // namespace bench
@@ -0,0 +1,369 @@
+#pragma once
+
+// Register bytecode VM with switch and direct-threaded dispatch
+//
+// basic_concepts_iii dispatches over `enum class E { A, B, C }` with a
+// `switch`. An interpreter loop built the same way compiles to one indirect
+// jump (through the case table) shared by every opcode; the predictor sees a
+// single branch whose target changes almost every instruction, and misses
+// whenever the previous opcode isn't enough to guess the next.
+//
+//   - `run_switch`   - `for (;;) switch (op)`: the baseline
+//   - `run_threaded` - direct threading: `thread(program)` stores, per
+//     instruction, the address of its handler label (GNU labels-as-values,
+//     gcc and clang), and every handler ends in its own `goto *next`. Each
+//     opcode gets its own indirect jump, so the predictor learns "what comes
+//     after an `add`" separately from "what comes after a `jump_if`", and
+//     there is no bounds check or table load per instruction.
+//
+// Programs are sequences of fixed 8-byte `Instr { op, a, b, c, imm }` over
+// 16 `int64_t` registers and a read-only input span; arithmetic wraps.
+// `Program` validates registers, jump targets and termination once, so the
+// interpreters don't check anything per instruction. `Op` is introspected
+// with `enum_container` (opcode count and names for `disassemble`).
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "enum_container/enum_container.hpp"
+
+namespace bytecode_vm {
+
+enum class Op : std::uint8_t {
+    load,        // r[a] = imm
+    input,       // r[a] = inputs[imm]
+    mov,         // r[a] = r[b]
+    add,         // r[a] = r[b] + r[c]
+    add_imm,     // r[a] = r[b] + imm
+    sub,         // r[a] = r[b] - r[c]
+    mul,         // r[a] = r[b] * r[c]
+    bit_and,     // r[a] = r[b] & r[c]
+    shr,         // r[a] = r[b] >> (r[c] & 63)
+    lt,          // r[a] = r[b] < r[c]
+    eq,          // r[a] = r[b] == r[c]
+    jump,        // pc = imm
+    jump_if,     // if (r[a] != 0) pc = imm
+    jump_unless, // if (r[a] == 0) pc = imm
+    ret          // return r[a]
+};
+
+inline constexpr std::size_t num_ops = enum_container::enum_count<Op>;
+inline constexpr std::size_t num_registers = 16;
+
+struct Instr {
+    Op op;
+    std::uint8_t a = 0;
+    std::uint8_t b = 0;
+    std::uint8_t c = 0;
+    std::int32_t imm = 0;
+};
+
+using Registers = std::array<std::int64_t, num_registers>;
+
+class Program {
+  public:
+    // Throws `std::invalid_argument` for a register >= 16, a jump outside
+    // the program, an `input` past `num_inputs`, or a last instruction that
+    // falls through
+    Program(std::vector<Instr> code, std::size_t num_inputs)
+        : code_{std::move(code)}, num_inputs_{num_inputs} {
+        validate();
+    }
+
+    [[nodiscard]] auto code() const -> std::span<const Instr> {
+        return code_;
+    }
+    [[nodiscard]] auto num_inputs() const -> std::size_t {
+        return num_inputs_;
+    }
+
+  private:
+    void validate() const {
+        if (code_.empty()) {
+            throw std::invalid_argument{"bytecode_vm: empty program"};
+        }
+        for (const auto &in : code_) {
+            if (enum_container::to_index(in.op) >= num_ops ||
+                in.a >= num_registers || in.b >= num_registers ||
+                in.c >= num_registers) {
+                throw std::invalid_argument{"bytecode_vm: bad instruction"};
+            }
+            bool jumps = in.op == Op::jump || in.op == Op::jump_if ||
+                         in.op == Op::jump_unless;
+            if (jumps && (in.imm < 0 || static_cast<std::size_t>(in.imm) >=
+                                            code_.size())) {
+                throw std::invalid_argument{"bytecode_vm: bad jump target"};
+            }
+            if (in.op == Op::input &&
+                (in.imm < 0 ||
+                 static_cast<std::size_t>(in.imm) >= num_inputs_)) {
+                throw std::invalid_argument{"bytecode_vm: bad input index"};
+            }
+        }
+        auto last = code_.back().op;
+        if (last != Op::ret && last != Op::jump) {
+            throw std::invalid_argument{"bytecode_vm: falls off the end"};
+        }
+    }
+
+    std::vector<Instr> code_;
+    std::size_t num_inputs_;
+};
+
+inline auto disassemble(const Program &program) -> std::string {
+    std::string text;
+    for (std::size_t pc = 0; const auto &in : program.code()) {
+        text += std::to_string(pc++) + ": ";
+        text += enum_container::to_string(in.op);
+        text += " a=" + std::to_string(in.a) + " b=" + std::to_string(in.b) +
+                " c=" + std::to_string(in.c) +
+                " imm=" + std::to_string(in.imm) + "\n";
+    }
+    return text;
+}
+
+namespace detail {
+
+// Wrapping arithmetic (signed overflow is UB; unsigned wraps)
+inline auto wrap(std::uint64_t v) -> std::int64_t {
+    return static_cast<std::int64_t>(v);
+}
+inline auto bits(std::int64_t v) -> std::uint64_t {
+    return static_cast<std::uint64_t>(v);
+}
+
+inline void check_inputs(const Program &program,
+                         std::span<const std::int64_t> inputs) {
+    if (inputs.size() < program.num_inputs()) {
+        throw std::invalid_argument{"bytecode_vm: too few inputs"};
+    }
+}
+
+// `Count`: also add the number of executed instructions to `steps`
+template <bool Count>
+auto interpret_switch(std::span<const Instr> code,
+                      std::span<const std::int64_t> inputs,
+                      std::uint64_t &steps) -> std::int64_t {
+    Registers r{};
+    const Instr *base = code.data();
+    std::size_t pc = 0;
+    for (;;) {
+        const Instr in = base[pc++];
+        if constexpr (Count) {
+            steps++;
+        }
+        switch (in.op) {
+        case Op::load:
+            r[in.a] = in.imm;
+            break;
+        case Op::input:
+            r[in.a] = inputs[static_cast<std::size_t>(in.imm)];
+            break;
+        case Op::mov:
+            r[in.a] = r[in.b];
+            break;
+        case Op::add:
+            r[in.a] = wrap(bits(r[in.b]) + bits(r[in.c]));
+            break;
+        case Op::add_imm:
+            r[in.a] = wrap(bits(r[in.b]) + bits(in.imm));
+            break;
+        case Op::sub:
+            r[in.a] = wrap(bits(r[in.b]) - bits(r[in.c]));
+            break;
+        case Op::mul:
+            r[in.a] = wrap(bits(r[in.b]) * bits(r[in.c]));
+            break;
+        case Op::bit_and:
+            r[in.a] = r[in.b] & r[in.c];
+            break;
+        case Op::shr:
+            r[in.a] = r[in.b] >> (r[in.c] & 63);
+            break;
+        case Op::lt:
+            r[in.a] = r[in.b] < r[in.c] ? 1 : 0;
+            break;
+        case Op::eq:
+            r[in.a] = r[in.b] == r[in.c] ? 1 : 0;
+            break;
+        case Op::jump:
+            pc = static_cast<std::size_t>(in.imm);
+            break;
+        case Op::jump_if:
+            if (r[in.a] != 0) {
+                pc = static_cast<std::size_t>(in.imm);
+            }
+            break;
+        case Op::jump_unless:
+            if (r[in.a] == 0) {
+                pc = static_cast<std::size_t>(in.imm);
+            }
+            break;
+        case Op::ret:
+            return r[in.a];
+        }
+    }
+}
+
+} // namespace detail
+
+inline auto run_switch(const Program &program,
+                       std::span<const std::int64_t> inputs) -> std::int64_t {
+    detail::check_inputs(program, inputs);
+    std::uint64_t steps = 0;
+    return detail::interpret_switch<false>(program.code(), inputs, steps);
+}
+
+// Number of instructions `run_switch` / `run_threaded` execute on `inputs`
+inline auto count_instructions(const Program &program,
+                               std::span<const std::int64_t> inputs)
+    -> std::uint64_t {
+    detail::check_inputs(program, inputs);
+    std::uint64_t steps = 0;
+    detail::interpret_switch<true>(program.code(), inputs, steps);
+    return steps;
+}
+
+// ===== Direct threading =====
+
+// An instruction with the address of its handler
+struct ThreadedInstr {
+    const void *handler;
+    Instr instr;
+};
+
+namespace detail {
+
+// Computed goto is a GNU extension (`-pedantic-errors` rejects it)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+
+// Runs `code`; with `code == nullptr`, instead points `*handlers` at the
+// handler addresses (in `Op` order), which only exist inside this function
+inline auto interpret_threaded(const ThreadedInstr *code,
+                               std::span<const std::int64_t> inputs,
+                               const void *const **handlers) -> std::int64_t {
+    static const void *const labels[] = {
+        &&op_load,    &&op_input, &&op_mov,     &&op_add,     &&op_add_imm,
+        &&op_sub,     &&op_mul,   &&op_bit_and, &&op_shr,     &&op_lt,
+        &&op_eq,      &&op_jump,  &&op_jump_if, &&op_jump_unless,
+        &&op_ret};
+    static_assert(std::size(labels) == num_ops);
+    if (code == nullptr) {
+        *handlers = labels;
+        return 0;
+    }
+
+    Registers r{};
+    const ThreadedInstr *ip = code;
+    const Instr *in = nullptr;
+// Fetch the next instruction and jump straight to its handler
+#define BYTECODE_VM_NEXT()                                                     \
+    in = &ip->instr;                                                           \
+    goto *(ip++)->handler
+
+    BYTECODE_VM_NEXT();
+op_load:
+    r[in->a] = in->imm;
+    BYTECODE_VM_NEXT();
+op_input:
+    r[in->a] = inputs[static_cast<std::size_t>(in->imm)];
+    BYTECODE_VM_NEXT();
+op_mov:
+    r[in->a] = r[in->b];
+    BYTECODE_VM_NEXT();
+op_add:
+    r[in->a] = wrap(bits(r[in->b]) + bits(r[in->c]));
+    BYTECODE_VM_NEXT();
+op_add_imm:
+    r[in->a] = wrap(bits(r[in->b]) + bits(in->imm));
+    BYTECODE_VM_NEXT();
+op_sub:
+    r[in->a] = wrap(bits(r[in->b]) - bits(r[in->c]));
+    BYTECODE_VM_NEXT();
+op_mul:
+    r[in->a] = wrap(bits(r[in->b]) * bits(r[in->c]));
+    BYTECODE_VM_NEXT();
+op_bit_and:
+    r[in->a] = r[in->b] & r[in->c];
+    BYTECODE_VM_NEXT();
+op_shr:
+    r[in->a] = r[in->b] >> (r[in->c] & 63);
+    BYTECODE_VM_NEXT();
+op_lt:
+    r[in->a] = r[in->b] < r[in->c] ? 1 : 0;
+    BYTECODE_VM_NEXT();
+op_eq:
+    r[in->a] = r[in->b] == r[in->c] ? 1 : 0;
+    BYTECODE_VM_NEXT();
+op_jump:
+    ip = code + in->imm;
+    BYTECODE_VM_NEXT();
+op_jump_if:
+    if (r[in->a] != 0) {
+        ip = code + in->imm;
+    }
+    BYTECODE_VM_NEXT();
+op_jump_unless:
+    if (r[in->a] == 0) {
+        ip = code + in->imm;
+    }
+    BYTECODE_VM_NEXT();
+op_ret:
+    return r[in->a];
+
+#undef BYTECODE_VM_NEXT
+}
+
+#pragma GCC diagnostic pop
+
+} // namespace detail
+
+class ThreadedProgram {
+  public:
+    explicit ThreadedProgram(const Program &program)
+        : num_inputs_{program.num_inputs()} {
+        const void *const *handlers = nullptr;
+        detail::interpret_threaded(nullptr, {}, &handlers);
+        code_.reserve(program.code().size());
+        for (const auto &in : program.code()) {
+            code_.push_back(
+                {handlers[enum_container::to_index(in.op)], in});
+        }
+    }
+
+    [[nodiscard]] auto code() const -> std::span<const ThreadedInstr> {
+        return code_;
+    }
+    [[nodiscard]] auto num_inputs() const -> std::size_t {
+        return num_inputs_;
+    }
+
+  private:
+    std::vector<ThreadedInstr> code_;
+    std::size_t num_inputs_;
+};
+
+// Translate once, run many times
+inline auto thread(const Program &program) -> ThreadedProgram {
+    return ThreadedProgram{program};
+}
+
+inline auto run_threaded(const ThreadedProgram &program,
+                         std::span<const std::int64_t> inputs)
+    -> std::int64_t {
+    if (inputs.size() < program.num_inputs()) {
+        throw std::invalid_argument{"bytecode_vm: too few inputs"};
+    }
+    return detail::interpret_threaded(program.code().data(), inputs,
+                                      nullptr);
+}
+
+} // namespace bytecode_vm
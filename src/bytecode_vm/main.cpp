@@ -0,0 +1,195 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <print>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "bench/perf_counter.hpp"
+#include "bytecode_vm/bytecode_vm.hpp"
+
+using namespace std;
+
+#define PRINT_VAR(var) std::println("{} = {}", #var, var);
+
+constexpr size_t num_transactions = 1'000'000;
+constexpr size_t num_collatz_starts = 100'000;
+constexpr int64_t max_collatz_start = 100'000;
+constexpr int reps = 5;
+
+using bytecode_vm::Instr;
+using bytecode_vm::Op;
+using bytecode_vm::Program;
+
+// Rule: score a transaction {amount, country, hour, count}
+// - straight-line code with data-dependent forward jumps
+auto score_rule() -> Program {
+    vector<Instr> code{
+        {.op = Op::input, .a = 1, .imm = 0}, // amount
+        {.op = Op::input, .a = 2, .imm = 1}, // country
+        {.op = Op::input, .a = 3, .imm = 2}, // hour
+        {.op = Op::input, .a = 4, .imm = 3}, // count
+        {.op = Op::load, .a = 0, .imm = 0},  // score
+        {.op = Op::load, .a = 5, .imm = 1000},
+        {.op = Op::lt, .a = 6, .b = 5, .c = 1},
+        {.op = Op::jump_unless, .a = 6, .imm = 9},
+        {.op = Op::add_imm, .a = 0, .b = 0, .imm = 40},
+        {.op = Op::load, .a = 5, .imm = 7}, // 9
+        {.op = Op::eq, .a = 6, .b = 2, .c = 5},
+        {.op = Op::jump_unless, .a = 6, .imm = 13},
+        {.op = Op::add_imm, .a = 0, .b = 0, .imm = 25},
+        {.op = Op::load, .a = 5, .imm = 6}, // 13
+        {.op = Op::lt, .a = 6, .b = 3, .c = 5},
+        {.op = Op::jump_unless, .a = 6, .imm = 17},
+        {.op = Op::add_imm, .a = 0, .b = 0, .imm = 15},
+        {.op = Op::load, .a = 5, .imm = 3}, // 17
+        {.op = Op::lt, .a = 6, .b = 5, .c = 4},
+        {.op = Op::jump_unless, .a = 6, .imm = 23},
+        {.op = Op::load, .a = 5, .imm = 5},
+        {.op = Op::mul, .a = 7, .b = 4, .c = 5},
+        {.op = Op::add, .a = 0, .b = 0, .c = 7},
+        {.op = Op::ret, .a = 0}, // 23
+    };
+    return Program{std::move(code), 4};
+}
+
+auto native_score(span<const int64_t> in) -> int64_t {
+    int64_t score = 0;
+    score += in[0] > 1000 ? 40 : 0;
+    score += in[1] == 7 ? 25 : 0;
+    score += in[2] < 6 ? 15 : 0;
+    score += in[3] > 3 ? in[3] * 5 : 0;
+    return score;
+}
+
+// Loop: Collatz steps from `n` down to 1
+// - a backward jump per step, and an even/odd branch inside
+auto collatz_rule() -> Program {
+    vector<Instr> code{
+        {.op = Op::input, .a = 1, .imm = 0}, // n
+        {.op = Op::load, .a = 0, .imm = 0},  // steps
+        {.op = Op::load, .a = 2, .imm = 1},
+        {.op = Op::load, .a = 3, .imm = 3},
+        {.op = Op::eq, .a = 4, .b = 1, .c = 2}, // 4: loop
+        {.op = Op::jump_if, .a = 4, .imm = 14},
+        {.op = Op::bit_and, .a = 4, .b = 1, .c = 2},
+        {.op = Op::jump_unless, .a = 4, .imm = 11},
+        {.op = Op::mul, .a = 1, .b = 1, .c = 3},
+        {.op = Op::add_imm, .a = 1, .b = 1, .imm = 1},
+        {.op = Op::jump, .imm = 12},
+        {.op = Op::shr, .a = 1, .b = 1, .c = 2}, // 11
+        {.op = Op::add_imm, .a = 0, .b = 0, .imm = 1},
+        {.op = Op::jump, .imm = 4},
+        {.op = Op::ret, .a = 0}, // 14
+    };
+    return Program{std::move(code), 1};
+}
+
+auto native_collatz(span<const int64_t> in) -> int64_t {
+    int64_t n = in[0];
+    int64_t steps = 0;
+    while (n != 1) {
+        n = (n & 1) != 0 ? (3 * n) + 1 : n >> 1;
+        steps++;
+    }
+    return steps;
+}
+
+// `records` holds inputs of `width` values each
+void bench_program(const char *title, const Program &program,
+                   const vector<int64_t> &records, size_t width,
+                   int64_t (*native)(span<const int64_t>)) {
+    auto num_records = records.size() / width;
+    auto record = [&](size_t i) {
+        return span<const int64_t>{records}.subspan(i * width, width);
+    };
+    uint64_t instructions = 0;
+    for (size_t i = 0; i < num_records; i++) {
+        instructions += bytecode_vm::count_instructions(program, record(i));
+    }
+    println("\n{}: {} records, {} bytecode instructions ({:.1f} per run):",
+            title, num_records, instructions,
+            static_cast<double>(instructions) /
+                static_cast<double>(num_records));
+
+    bench::PerfCounter misses{bench::Event::branch_misses};
+    auto threaded = bytecode_vm::thread(program);
+    auto run = [&](const char *label, auto &&fn) {
+        int64_t sum = 0;
+        auto t = bench::time_best(reps, [&] {
+            sum = 0;
+            for (size_t i = 0; i < num_records; i++) {
+                sum += fn(record(i));
+            }
+        });
+        bench::report(label, t, static_cast<double>(instructions),
+                      "instructions");
+        auto count = misses.count([&] {
+            for (size_t i = 0; i < num_records; i++) {
+                bench::do_not_optimize(fn(record(i)));
+            }
+        });
+        if (misses.available()) {
+            println("    branch misses: {} ({:.2f} per 100 instructions)",
+                    count,
+                    100.0 * static_cast<double>(count) /
+                        static_cast<double>(instructions));
+        }
+        return sum;
+    };
+    auto expected = run("native C++", native);
+    auto switched = run("switch dispatch", [&](span<const int64_t> in) {
+        return bytecode_vm::run_switch(program, in);
+    });
+    auto goto_total = run("computed goto (direct threaded)",
+                          [&](span<const int64_t> in) {
+                              return bytecode_vm::run_threaded(threaded, in);
+                          });
+    if (!misses.available()) {
+        println("    branch misses: unavailable (no perf events here)");
+    }
+    println("  results match: {}",
+            switched == expected && goto_total == expected);
+}
+
+auto main() -> int {
+    println("Bytecode VM - switch vs computed-goto dispatch");
+
+    // basic_concepts_iii: a `switch` over an enum, as an opcode set
+    auto num_ops = bytecode_vm::num_ops;
+    PRINT_VAR(num_ops)
+    auto sizeof_instr = sizeof(Instr);
+    PRINT_VAR(sizeof_instr)
+    auto collatz = collatz_rule();
+    print("{}", bytecode_vm::disassemble(collatz));
+    array<int64_t, 1> twenty_seven{27};
+    PRINT_VAR(bytecode_vm::run_switch(collatz, twenty_seven))
+    PRINT_VAR(bytecode_vm::run_threaded(bytecode_vm::thread(collatz),
+                                        twenty_seven))
+    try {
+        Program bad{{{.op = Op::jump, .imm = 5}}, 0};
+    } catch (const invalid_argument &e) {
+        println("validation: {}", e.what());
+    }
+
+    mt19937 rng{19};
+    auto uniform = [&](uint32_t n) { return static_cast<int64_t>(rng() % n); };
+    vector<int64_t> transactions(num_transactions * 4);
+    for (size_t i = 0; i < num_transactions; i++) {
+        transactions[(i * 4) + 0] = uniform(2000);
+        transactions[(i * 4) + 1] = uniform(10);
+        transactions[(i * 4) + 2] = uniform(24);
+        transactions[(i * 4) + 3] = uniform(7);
+    }
+    bench_program("score rule", score_rule(), transactions, 4, native_score);
+
+    vector<int64_t> starts(num_collatz_starts);
+    for (auto &n : starts) {
+        n = 1 + uniform(max_collatz_start);
+    }
+    bench_program("Collatz loop", collatz, starts, 1, native_collatz);
+}
@@ -0,0 +1,315 @@
+#pragma once
+
+// Overflow-checked and saturating integer arithmetic
+//
+// basic_concepts_ii: `INT_MAX + 1` and `INT_MIN * -1` are undefined behavior,
+// `UINT_MAX + 1` silently wraps to 0. Two scalar wrappers over the
+// fixed-width types make the overflow policy part of the type:
+//   - `checked<T>`    - computes the wrapped result and a sticky `overflowed`
+//                       flag (like a NaN, it propagates through later
+//                       operations); `value()` throws `std::overflow_error`
+//                       if any step overflowed, so a chain of operations
+//                       costs one branch, at the end
+//   - `saturating<T>` - clamps to [numeric_limits<T>::min(), max()]
+// Both use the compiler's `__builtin_*_overflow` (gcc/clang), which compile
+// to the add/sub/mul plus a read of the CPU's overflow or carry flag.
+//
+// The batch kernels (`add`, `sub`, `mul`, `sum` over spans) write wrapped
+// results and return one flag for "any element overflowed", OR-ing per-lane
+// overflow masks instead of branching per element.
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <experimental/simd>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace checked_int {
+
+namespace stdx = std::experimental;
+
+// The fixed-width types (and the other integer types they alias); not `bool`
+// or the character types
+template <typename T>
+concept fixed_width_integer =
+    std::integral<T> && !std::same_as<T, bool> && !std::same_as<T, char> &&
+    !std::same_as<T, char8_t> && !std::same_as<T, char16_t> &&
+    !std::same_as<T, char32_t> && !std::same_as<T, wchar_t>;
+
+template <fixed_width_integer T> class checked {
+  public:
+    constexpr checked() = default;
+    constexpr checked(T value) : value_{value} {} // NOLINT(*-explicit-*)
+
+    // Throws `std::overflow_error` if any operation leading here overflowed
+    [[nodiscard]] constexpr auto value() const -> T {
+        if (overflowed_) {
+            throw std::overflow_error{"checked_int: integer overflow"};
+        }
+        return value_;
+    }
+    // The wrapped result, whether or not it overflowed
+    [[nodiscard]] constexpr auto wrapped() const -> T { return value_; }
+    [[nodiscard]] constexpr auto overflowed() const -> bool {
+        return overflowed_;
+    }
+
+    friend constexpr auto operator+(checked a, checked b) -> checked {
+        checked r;
+        r.overflowed_ = __builtin_add_overflow(a.value_, b.value_, &r.value_) |
+                        a.overflowed_ | b.overflowed_;
+        return r;
+    }
+    friend constexpr auto operator-(checked a, checked b) -> checked {
+        checked r;
+        r.overflowed_ = __builtin_sub_overflow(a.value_, b.value_, &r.value_) |
+                        a.overflowed_ | b.overflowed_;
+        return r;
+    }
+    friend constexpr auto operator*(checked a, checked b) -> checked {
+        checked r;
+        r.overflowed_ = __builtin_mul_overflow(a.value_, b.value_, &r.value_) |
+                        a.overflowed_ | b.overflowed_;
+        return r;
+    }
+    // Division overflows for `x / 0` and `min / -1`
+    friend constexpr auto operator/(checked a, checked b) -> checked {
+        checked r;
+        bool bad = b.value_ == 0;
+        if constexpr (std::is_signed_v<T>) {
+            bad = bad || (a.value_ == std::numeric_limits<T>::min() &&
+                          b.value_ == -1);
+        }
+        r.value_ = bad ? T{0} : static_cast<T>(a.value_ / b.value_);
+        r.overflowed_ = bad || a.overflowed_ || b.overflowed_;
+        return r;
+    }
+
+    constexpr auto operator+=(checked other) -> checked & {
+        return *this = *this + other;
+    }
+    constexpr auto operator-=(checked other) -> checked & {
+        return *this = *this - other;
+    }
+    constexpr auto operator*=(checked other) -> checked & {
+        return *this = *this * other;
+    }
+    constexpr auto operator/=(checked other) -> checked & {
+        return *this = *this / other;
+    }
+
+  private:
+    T value_{};
+    bool overflowed_ = false;
+};
+
+template <fixed_width_integer T> class saturating {
+  public:
+    constexpr saturating() = default;
+    constexpr saturating(T value) : value_{value} {} // NOLINT(*-explicit-*)
+
+    [[nodiscard]] constexpr auto value() const -> T { return value_; }
+
+    friend constexpr auto operator+(saturating a, saturating b)
+        -> saturating {
+        T r{};
+        if (__builtin_add_overflow(a.value_, b.value_, &r)) {
+            // only same-sign operands overflow; the sign says which bound
+            return negative(b.value_) ? min : max;
+        }
+        return r;
+    }
+    friend constexpr auto operator-(saturating a, saturating b)
+        -> saturating {
+        T r{};
+        if (__builtin_sub_overflow(a.value_, b.value_, &r)) {
+            return negative(b.value_) ? max : min;
+        }
+        return r;
+    }
+    friend constexpr auto operator*(saturating a, saturating b)
+        -> saturating {
+        T r{};
+        if (__builtin_mul_overflow(a.value_, b.value_, &r)) {
+            return negative(a.value_) != negative(b.value_) ? min : max;
+        }
+        return r;
+    }
+
+    constexpr auto operator+=(saturating other) -> saturating & {
+        return *this = *this + other;
+    }
+    constexpr auto operator-=(saturating other) -> saturating & {
+        return *this = *this - other;
+    }
+    constexpr auto operator*=(saturating other) -> saturating & {
+        return *this = *this * other;
+    }
+
+  private:
+    static constexpr T min = std::numeric_limits<T>::min();
+    static constexpr T max = std::numeric_limits<T>::max();
+
+    static constexpr auto negative(T v) -> bool {
+        if constexpr (std::is_signed_v<T>) {
+            return v < 0;
+        } else {
+            return false;
+        }
+    }
+    T value_{};
+};
+
+// ===== Batch kernels =====
+
+namespace detail {
+
+template <typename T> using simd_t = stdx::native_simd<T>;
+
+// Per-lane overflow of the wrapped `sum = a + b` / `diff = a - b`
+template <typename T>
+auto add_overflow(const simd_t<T> &a, const simd_t<T> &b,
+                  const simd_t<T> &sum) {
+    if constexpr (std::is_signed_v<T>) {
+        return ((a ^ sum) & (b ^ sum)) < 0;
+    } else {
+        return sum < a;
+    }
+}
+template <typename T>
+auto sub_overflow(const simd_t<T> &a, const simd_t<T> &b,
+                  const simd_t<T> &diff) {
+    if constexpr (std::is_signed_v<T>) {
+        return ((a ^ b) & (a ^ diff)) < 0;
+    } else {
+        return a < b;
+    }
+}
+
+} // namespace detail
+
+// out[i] = a[i] + b[i] (wrapped); returns whether any element overflowed
+template <fixed_width_integer T>
+auto add(std::span<const T> a, std::span<const T> b, std::span<T> out)
+    -> bool {
+    using V = detail::simd_t<T>;
+    // add as unsigned: like the scalar `+`, signed simd addition may be
+    // assumed not to overflow
+    using U = detail::simd_t<std::make_unsigned_t<T>>;
+    typename V::mask_type overflow{false};
+    std::size_t i = 0;
+    for (; i + V::size() <= out.size(); i += V::size()) {
+        V va{a.data() + i, stdx::element_aligned};
+        V vb{b.data() + i, stdx::element_aligned};
+        auto sum = stdx::static_simd_cast<V>(stdx::static_simd_cast<U>(va) +
+                                             stdx::static_simd_cast<U>(vb));
+        overflow = overflow || detail::add_overflow<T>(va, vb, sum);
+        sum.copy_to(out.data() + i, stdx::element_aligned);
+    }
+    bool any = stdx::any_of(overflow);
+    for (; i < out.size(); i++) {
+        any |= __builtin_add_overflow(a[i], b[i], &out[i]);
+    }
+    return any;
+}
+
+// out[i] = a[i] - b[i] (wrapped); returns whether any element overflowed
+template <fixed_width_integer T>
+auto sub(std::span<const T> a, std::span<const T> b, std::span<T> out)
+    -> bool {
+    using V = detail::simd_t<T>;
+    using U = detail::simd_t<std::make_unsigned_t<T>>;
+    typename V::mask_type overflow{false};
+    std::size_t i = 0;
+    for (; i + V::size() <= out.size(); i += V::size()) {
+        V va{a.data() + i, stdx::element_aligned};
+        V vb{b.data() + i, stdx::element_aligned};
+        auto diff = stdx::static_simd_cast<V>(stdx::static_simd_cast<U>(va) -
+                                              stdx::static_simd_cast<U>(vb));
+        overflow = overflow || detail::sub_overflow<T>(va, vb, diff);
+        diff.copy_to(out.data() + i, stdx::element_aligned);
+    }
+    bool any = stdx::any_of(overflow);
+    for (; i < out.size(); i++) {
+        any |= __builtin_sub_overflow(a[i], b[i], &out[i]);
+    }
+    return any;
+}
+
+// out[i] = a[i] * b[i] (wrapped); returns whether any element overflowed
+// - up to 32-bit types: exact products in 64-bit lanes, checked by range
+// - 64-bit types: no wider lanes to widen into; per-element builtins, OR-ed
+//   without branching
+template <fixed_width_integer T>
+auto mul(std::span<const T> a, std::span<const T> b, std::span<T> out)
+    -> bool {
+    std::size_t i = 0;
+    bool any = false;
+    if constexpr (sizeof(T) <= 4) {
+        constexpr std::size_t width = 8;
+        using V = stdx::fixed_size_simd<T, width>;
+        using wide_int = std::conditional_t<std::is_signed_v<T>, std::int64_t,
+                                            std::uint64_t>;
+        using W = stdx::fixed_size_simd<wide_int, width>;
+        typename W::mask_type overflow{false};
+        for (; i + width <= out.size(); i += width) {
+            auto product = stdx::static_simd_cast<W>(
+                               V{a.data() + i, stdx::element_aligned}) *
+                           stdx::static_simd_cast<W>(
+                               V{b.data() + i, stdx::element_aligned});
+            overflow = overflow ||
+                       product < W{wide_int{std::numeric_limits<T>::min()}} ||
+                       product > W{wide_int{std::numeric_limits<T>::max()}};
+            // wrap to T through the unsigned type (modular)
+            using U = std::make_unsigned_t<T>;
+            stdx::static_simd_cast<V>(
+                stdx::static_simd_cast<stdx::fixed_size_simd<U, width>>(
+                    product))
+                .copy_to(out.data() + i, stdx::element_aligned);
+        }
+        any = stdx::any_of(overflow);
+    }
+    for (; i < out.size(); i++) {
+        any |= __builtin_mul_overflow(a[i], b[i], &out[i]);
+    }
+    return any;
+}
+
+template <fixed_width_integer T> struct SumResult {
+    T sum;
+    bool overflowed;
+};
+
+// Sum of `values` (wrapped) and whether any partial sum overflowed
+// - the partial sums are per lane, so a sum whose intermediate values
+//   overflow but whose final value fits may still report overflow
+template <fixed_width_integer T>
+auto sum(std::span<const T> values) -> SumResult<T> {
+    using V = detail::simd_t<T>;
+    using U = detail::simd_t<std::make_unsigned_t<T>>;
+    V acc = 0;
+    typename V::mask_type overflow{false};
+    std::size_t i = 0;
+    for (; i + V::size() <= values.size(); i += V::size()) {
+        V v{values.data() + i, stdx::element_aligned};
+        auto next = stdx::static_simd_cast<V>(stdx::static_simd_cast<U>(acc) +
+                                              stdx::static_simd_cast<U>(v));
+        overflow = overflow || detail::add_overflow<T>(acc, v, next);
+        acc = next;
+    }
+    SumResult<T> result{T{0}, stdx::any_of(overflow)};
+    for (std::size_t lane = 0; lane < V::size(); lane++) {
+        result.overflowed |=
+            __builtin_add_overflow(result.sum, T{acc[lane]}, &result.sum);
+    }
+    for (; i < values.size(); i++) {
+        result.overflowed |=
+            __builtin_add_overflow(result.sum, values[i], &result.sum);
+    }
+    return result;
+}
+
+} // namespace checked_int
@@ -0,0 +1,140 @@
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <print>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "checked_int/checked_int.hpp"
+
+using namespace std;
+
+#define PRINT_VAR(var) std::println("{} = {}", #var, var);
+
+constexpr size_t num_values = 16'000'000;
+constexpr int reps = 5;
+
+using checked_int::checked;
+using checked_int::saturating;
+
+template <typename T> //
+auto make_column(T lo, T hi, unsigned seed) -> vector<T> {
+    mt19937_64 rng{seed};
+    uniform_int_distribution<T> dist{lo, hi};
+    vector<T> column(num_values);
+    for (auto &v : column) {
+        v = dist(rng);
+    }
+    return column;
+}
+
+// Unchecked baseline; wraps through the unsigned type so that the full-range
+// runs aren't themselves signed-overflow UB
+template <typename T> //
+auto wrapping_add(T a, T b) -> T {
+    using U = make_unsigned_t<T>;
+    return static_cast<T>(
+        static_cast<U>(static_cast<U>(a) + static_cast<U>(b)));
+}
+
+template <typename T> //
+void run_elementwise(const char *label, T lo, T hi) {
+    auto a = make_column<T>(lo, hi, 1);
+    auto b = make_column<T>(lo, hi, 2);
+    vector<T> out(num_values);
+    println("\n{}:", label);
+
+    auto t = bench::time_best(reps, [&] {
+        for (size_t i = 0; i < num_values; i++) {
+            out[i] = wrapping_add(a[i], b[i]);
+        }
+        bench::do_not_optimize(out.data());
+    });
+    bench::report("unchecked a + b", t, num_values, "values");
+
+    bool any = false;
+    t = bench::time_best(reps, [&] {
+        any = false;
+        for (size_t i = 0; i < num_values; i++) {
+            auto r = checked<T>{a[i]} + checked<T>{b[i]};
+            out[i] = r.wrapped();
+            any |= r.overflowed();
+        }
+        bench::do_not_optimize(out.data());
+    });
+    bench::report("checked<T> loop", t, num_values, "values");
+
+    t = bench::time_best(reps, [&] {
+        for (size_t i = 0; i < num_values; i++) {
+            out[i] = (saturating<T>{a[i]} + saturating<T>{b[i]}).value();
+        }
+        bench::do_not_optimize(out.data());
+    });
+    bench::report("saturating<T> loop", t, num_values, "values");
+
+    t = bench::time_best(reps, [&] {
+        any = checked_int::add(span<const T>{a}, span<const T>{b}, span{out});
+        bench::do_not_optimize(out.data());
+    });
+    bench::report("checked_int::add batch", t, num_values, "values");
+    PRINT_VAR(any)
+
+    t = bench::time_best(reps, [&] {
+        any = checked_int::mul(span<const T>{a}, span<const T>{b}, span{out});
+        bench::do_not_optimize(out.data());
+    });
+    bench::report("checked_int::mul batch", t, num_values, "values");
+    PRINT_VAR(any)
+}
+
+template <typename T> //
+void run_sum(const char *label, T lo, T hi) {
+    auto values = make_column<T>(lo, hi, 3);
+    println("\n{}:", label);
+
+    T total = 0;
+    auto t = bench::time_best(reps, [&] {
+        total = 0;
+        for (T v : values) {
+            total = wrapping_add(total, v);
+        }
+        bench::do_not_optimize(total);
+    });
+    bench::report("unchecked sum", t, num_values, "values");
+
+    checked_int::SumResult<T> result{};
+    t = bench::time_best(reps, [&] {
+        result = checked_int::sum(span<const T>{values});
+        bench::do_not_optimize(result);
+    });
+    bench::report("checked_int::sum", t, num_values, "values");
+    println("  sums match: {}, overflowed: {}", result.sum == total,
+            result.overflowed);
+}
+
+auto main() -> int {
+    println("Checked Int - overflow-checked and saturating arithmetic");
+
+    println("\nthe basic_concepts_ii cases:");
+    PRINT_VAR((checked<int>{INT_MAX} + 1).overflowed())
+    PRINT_VAR((checked<int>{INT_MIN} * -1).overflowed())
+    PRINT_VAR((checked<unsigned>{UINT_MAX} + 1U).overflowed())
+    PRINT_VAR((saturating<int>{INT_MAX} + 1).value())
+    PRINT_VAR((saturating<unsigned>{0U} - 1U).value())
+    try {
+        auto _ = (checked<int16_t>{int16_t{30'000}} + int16_t{30'000}).value();
+    } catch (const std::overflow_error &e) {
+        println("checked<int16_t>{{30'000}} + 30'000 threw: {}", e.what());
+    }
+
+    println("\n{} values per column", num_values);
+    run_elementwise<int32_t>("int32, values that never overflow", -1000, 1000);
+    run_elementwise<int32_t>("int32, full range", INT32_MIN, INT32_MAX);
+    run_elementwise<uint64_t>("uint64, values that never overflow", 0, 1000);
+    run_sum<int64_t>("int64 sum, small values", -1000, 1000);
+    run_sum<int32_t>("int32 sum, large values", 0, INT32_MAX);
+}
@@ -0,0 +1,278 @@
+#pragma once
+
+// Bit-packed integer column encoding
+//
+// A column declared `uint64_t` (or `int32_t`, `size_t`, ...) often only holds
+// values that need a few bits. `Column<T>` splits the values into blocks of
+// 256 and stores each block as a reference value plus fixed-width offsets:
+//   - `Encoding::frame_of_reference` - reference = block minimum, offsets =
+//     value - minimum (good for values in a narrow range)
+//   - `Encoding::delta` - reference = first value, offsets = zigzag-encoded
+//     differences to the previous value (good for sorted/slowly changing
+//     data like timestamps or ids)
+// and the offsets are bit-packed at the smallest width that fits the block.
+// Offsets and deltas are taken modulo 2^N for an N-bit `T` (on its unsigned
+// type), so a signed block that crosses zero stays as narrow as the same
+// values would be unsigned.
+//
+// Packed layout (for SIMD decoding): a block is 4 interleaved lanes of
+// 64 values; value `j` lives in lane `j % 4` at position `j / 4`, and lane
+// words are interleaved (`word * 4 + lane`). All 4 lanes share the same word
+// index and shift for a given position, so decoding is 4 lanes of the same
+// shift/mask sequence - one `fixed_size_simd<uint64_t, 4>` - and each
+// position writes 4 consecutive output values.
+//
+// Random access: `operator[]` is O(1) for frame-of-reference (one packed
+// value is extracted); for delta it unpacks the value's block and sums the
+// deltas up to its position.
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <experimental/simd>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace column_codec {
+
+namespace stdx = std::experimental;
+
+inline constexpr std::size_t block_size = 256;
+inline constexpr std::size_t lanes = 4;
+inline constexpr std::size_t lane_values = block_size / lanes; // 64
+
+enum class Encoding : std::uint8_t { frame_of_reference, delta };
+
+namespace detail {
+
+using lane_simd = stdx::fixed_size_simd<std::uint64_t, lanes>;
+
+constexpr auto low_mask(unsigned bits) -> std::uint64_t {
+    return bits == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << bits) - 1;
+}
+
+// Pack 256 offsets at `Bits` each into `4 * Bits` words
+inline void pack(std::span<const std::uint64_t, block_size> values,
+                 unsigned bits, std::uint64_t *out) {
+    if (bits == 0) {
+        return; // all offsets are zero; nothing is stored
+    }
+    std::fill_n(out, std::size_t{lanes} * bits, 0);
+    for (std::size_t v = 0; v < lane_values; v++) {
+        auto bit = v * bits;
+        auto word = bit / 64;
+        auto shift = bit % 64;
+        for (std::size_t lane = 0; lane < lanes; lane++) {
+            auto value = values[(v * lanes) + lane];
+            out[(word * lanes) + lane] |= value << shift;
+            if (shift + bits > 64) {
+                out[((word + 1) * lanes) + lane] |= value >> (64 - shift);
+            }
+        }
+    }
+}
+
+// Unpack 256 offsets of width `Bits`; the width is a template parameter so
+// every shift is a constant and the loop fully unrolls
+template <unsigned Bits>
+void unpack(const std::uint64_t *in, std::uint64_t *out) {
+    if constexpr (Bits == 0) {
+        std::fill_n(out, block_size, 0);
+    } else {
+        const lane_simd mask{low_mask(Bits)};
+        for (std::size_t v = 0; v < lane_values; v++) {
+            auto bit = v * Bits;
+            auto word = bit / 64;
+            auto shift = static_cast<int>(bit % 64);
+            lane_simd value =
+                lane_simd{in + (word * lanes), stdx::element_aligned} >> shift;
+            if (shift + static_cast<int>(Bits) > 64) {
+                value |= lane_simd{in + ((word + 1) * lanes),
+                                   stdx::element_aligned}
+                         << (64 - shift);
+            }
+            value &= mask;
+            value.copy_to(out + (v * lanes), stdx::element_aligned);
+        }
+    }
+}
+
+using unpack_fn = void (*)(const std::uint64_t *, std::uint64_t *);
+
+template <std::size_t... Bits>
+constexpr auto make_unpack_table(std::index_sequence<Bits...>) {
+    return std::array<unpack_fn, sizeof...(Bits)>{&unpack<Bits>...};
+}
+
+// unpack_table[bits] decodes a block packed at `bits` bits
+inline constexpr auto unpack_table =
+    make_unpack_table(std::make_index_sequence<65>{});
+
+// Single packed value `j` of a block
+inline auto extract(const std::uint64_t *in, unsigned bits, std::size_t j)
+    -> std::uint64_t {
+    if (bits == 0) {
+        return 0;
+    }
+    auto lane = j % lanes;
+    auto bit = (j / lanes) * bits;
+    auto word = bit / 64;
+    auto shift = bit % 64;
+    auto value = in[(word * lanes) + lane] >> shift;
+    if (shift + bits > 64) {
+        value |= in[((word + 1) * lanes) + lane] << (64 - shift);
+    }
+    return value & low_mask(bits);
+}
+
+// At the width of `U`: small negative deltas must map to small codes there,
+// not only at 64 bits
+template <std::unsigned_integral U>
+constexpr auto zigzag(U delta) -> U {
+    constexpr int sign = std::numeric_limits<U>::digits - 1;
+    auto fill = static_cast<U>(-static_cast<U>(delta >> sign));
+    return static_cast<U>(static_cast<U>(delta << 1U) ^ fill);
+}
+template <std::unsigned_integral U> constexpr auto unzigzag(U z) -> U {
+    auto fill = static_cast<U>(-static_cast<U>(z & 1U));
+    return static_cast<U>(static_cast<U>(z >> 1U) ^ fill);
+}
+
+} // namespace detail
+
+template <std::integral T> class Column {
+  public:
+    using value_type = T;
+
+    static auto encode(std::span<const T> values, Encoding encoding)
+        -> Column {
+        Column column;
+        column.encoding_ = encoding;
+        column.size_ = values.size();
+        std::array<std::uint64_t, block_size> offsets{};
+        for (std::size_t first = 0; first < values.size();
+             first += block_size) {
+            auto n = std::min(block_size, values.size() - first);
+            auto block = values.subspan(first, n);
+            Block header{.reference = to_unsigned(block[0]),
+                         .word_offset = column.words_.size(),
+                         .bit_width = 0};
+            if (encoding == Encoding::frame_of_reference) {
+                auto min = to_unsigned(std::ranges::min(block));
+                header.reference = min;
+                for (std::size_t j = 0; j < n; j++) {
+                    offsets[j] = static_cast<U>(to_unsigned(block[j]) - min);
+                }
+            } else {
+                offsets[0] = 0;
+                for (std::size_t j = 1; j < n; j++) {
+                    offsets[j] = detail::zigzag(static_cast<U>(
+                        to_unsigned(block[j]) - to_unsigned(block[j - 1])));
+                }
+            }
+            std::fill(offsets.begin() + static_cast<std::ptrdiff_t>(n),
+                      offsets.end(), 0);
+            std::uint64_t all = 0;
+            for (auto o : offsets) {
+                all |= o;
+            }
+            header.bit_width = static_cast<std::uint8_t>(std::bit_width(all));
+            column.words_.resize(column.words_.size() +
+                                 (lanes * header.bit_width));
+            detail::pack(offsets, header.bit_width,
+                         column.words_.data() + header.word_offset);
+            column.blocks_.push_back(header);
+        }
+        return column;
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t { return size_; }
+    [[nodiscard]] auto num_blocks() const -> std::size_t {
+        return blocks_.size();
+    }
+    [[nodiscard]] auto encoding() const -> Encoding { return encoding_; }
+
+    // Packed words plus per-block headers
+    [[nodiscard]] auto compressed_bytes() const -> std::size_t {
+        return (words_.size() * sizeof(std::uint64_t)) +
+               (blocks_.size() * sizeof(Block));
+    }
+
+    // Decode block `b` into `out` (`block_size` values; the last block only
+    // fills `size() % block_size` of them)
+    void decode_block(std::size_t b, std::span<T> out) const {
+        alignas(32) std::array<std::uint64_t, block_size> offsets;
+        const auto &header = blocks_[b];
+        detail::unpack_table[header.bit_width](
+            words_.data() + header.word_offset, offsets.data());
+        auto n = std::min(block_size, size_ - (b * block_size));
+        if (encoding_ == Encoding::frame_of_reference) {
+            for (std::size_t j = 0; j < n; j++) {
+                out[j] = from_unsigned(header.reference + offsets[j]);
+            }
+        } else {
+            auto value = header.reference;
+            for (std::size_t j = 0; j < n; j++) {
+                value = static_cast<U>(
+                    value + detail::unzigzag(static_cast<U>(offsets[j])));
+                out[j] = from_unsigned(value);
+            }
+        }
+    }
+
+    // Decode everything into `out` (`size()` values)
+    void decode(std::span<T> out) const {
+        for (std::size_t b = 0; b < blocks_.size(); b++) {
+            decode_block(b, out.subspan(b * block_size));
+        }
+    }
+
+    auto operator[](std::size_t i) const -> T {
+        const auto &header = blocks_[i / block_size];
+        const auto *words = words_.data() + header.word_offset;
+        auto j = i % block_size;
+        if (encoding_ == Encoding::frame_of_reference) {
+            return from_unsigned(header.reference +
+                                 detail::extract(words, header.bit_width, j));
+        }
+        // delta: unpacking the whole block with the SIMD kernel beats
+        // extracting the preceding values one by one
+        alignas(32) std::array<std::uint64_t, block_size> offsets;
+        detail::unpack_table[header.bit_width](words, offsets.data());
+        auto value = header.reference;
+        for (std::size_t k = 1; k <= j; k++) {
+            value = static_cast<U>(
+                value + detail::unzigzag(static_cast<U>(offsets[k])));
+        }
+        return from_unsigned(value);
+    }
+
+  private:
+    using U = std::make_unsigned_t<T>;
+
+    // Values are handled as their unsigned bit pattern `U`, so every offset,
+    // delta and decoded sum wraps at T's width
+    static auto to_unsigned(T value) -> U { return static_cast<U>(value); }
+    static auto from_unsigned(std::uint64_t value) -> T {
+        return static_cast<T>(static_cast<U>(value));
+    }
+
+    struct Block {
+        U reference;
+        std::size_t word_offset;
+        std::uint8_t bit_width;
+    };
+
+    Encoding encoding_ = Encoding::frame_of_reference;
+    std::size_t size_ = 0;
+    std::vector<Block> blocks_;
+    std::vector<std::uint64_t> words_;
+};
+
+} // namespace column_codec
@@ -0,0 +1,169 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <print>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "column_codec/column_codec.hpp"
+
+using namespace std;
+
+#define PRINT_VAR(var) std::println("{} = {}", #var, var);
+
+constexpr size_t num_values = 32'000'000;
+constexpr size_t num_lookups = 4'000'000;
+constexpr int reps = 5;
+
+// The baseline: sum the raw column
+auto raw_sum(span<const uint64_t> values) -> uint64_t {
+    uint64_t sum = 0;
+    for (auto v : values) {
+        sum += v;
+    }
+    return sum;
+}
+
+// Decode one block at a time into a small buffer that stays in L1 and sum it
+auto decoded_sum(const column_codec::Column<uint64_t> &column) -> uint64_t {
+    alignas(32) array<uint64_t, column_codec::block_size> buf;
+    uint64_t sum = 0;
+    for (size_t b = 0; b < column.num_blocks(); b++) {
+        column.decode_block(b, buf);
+        auto n = min(column_codec::block_size,
+                     column.size() - (b * column_codec::block_size));
+        for (size_t j = 0; j < n; j++) {
+            sum += buf[j];
+        }
+    }
+    return sum;
+}
+
+// Small values on both sides of zero: the offsets and deltas must wrap at
+// T's width to stay a few bits wide; the extremes end the last block to
+// check the full-width case
+template <typename T> void signed_round_trip(const char *name) {
+    mt19937_64 rng{12};
+    uniform_int_distribution<int> small{-5, 5};
+    vector<T> values(1'024);
+    for (auto &v : values) {
+        v = static_cast<T>(small(rng));
+    }
+    values[values.size() - 2] = numeric_limits<T>::max();
+    values[values.size() - 1] = numeric_limits<T>::min();
+    for (auto encoding : {column_codec::Encoding::frame_of_reference,
+                          column_codec::Encoding::delta}) {
+        auto column = column_codec::Column<T>::encode(values, encoding);
+        vector<T> decoded(values.size());
+        column.decode(decoded);
+        auto indexed = true;
+        for (size_t i = 0; i < values.size(); i++) {
+            indexed = indexed && column[i] == values[i];
+        }
+        println("  {:<7} {:<18} {:>5} -> {:>4} bytes, round trip: {}", name,
+                encoding == column_codec::Encoding::delta
+                    ? "delta"
+                    : "frame of reference",
+                values.size() * sizeof(T), column.compressed_bytes(),
+                decoded == values && indexed);
+    }
+}
+
+void run(const char *label, const vector<uint64_t> &values,
+         column_codec::Encoding encoding) {
+    println("\n{}:", label);
+    auto column = column_codec::Column<uint64_t>::encode(values, encoding);
+    auto raw_bytes = static_cast<double>(values.size() * sizeof(uint64_t));
+    println("  compressed {:.1f} MB -> {:.1f} MB  (ratio {:.2f}x)",
+            raw_bytes / 1e6,
+            static_cast<double>(column.compressed_bytes()) / 1e6,
+            raw_bytes / static_cast<double>(column.compressed_bytes()));
+
+    uint64_t expected = 0;
+    auto t = bench::time_best(reps, [&] { expected = raw_sum(values); });
+    println("  {:<32} {:>8.2f} ms  {:>6.2f} GB/s", "raw uint64_t scan", t * 1e3,
+            raw_bytes / 1e9 / t);
+
+    uint64_t sum = 0;
+    t = bench::time_best(reps, [&] { sum = decoded_sum(column); });
+    println("  {:<32} {:>8.2f} ms  {:>6.2f} GB/s (decoded)",
+            "Column decode + scan", t * 1e3, raw_bytes / 1e9 / t);
+    println("  sums match: {}", sum == expected);
+
+    mt19937_64 rng{11};
+    uniform_int_distribution<size_t> pick{0, values.size() - 1};
+    vector<size_t> indices(num_lookups);
+    for (auto &i : indices) {
+        i = pick(rng);
+    }
+    t = bench::time_best(reps, [&] {
+        uint64_t acc = 0;
+        for (auto i : indices) {
+            acc += values[i];
+        }
+        bench::do_not_optimize(acc);
+    });
+    bench::report("raw random access", t, num_lookups, "lookups");
+    t = bench::time_best(reps, [&] {
+        uint64_t acc = 0;
+        for (auto i : indices) {
+            acc += column[i];
+        }
+        bench::do_not_optimize(acc);
+    });
+    bench::report("Column random access", t, num_lookups, "lookups");
+}
+
+auto main() -> int {
+    println("Column codec - bit-packed integer columns (FOR / delta)");
+
+    // basic_concepts_ii: a `uint64_t` that only ever holds 32
+    println("\na uint64_t column holding small values:");
+    vector<uint64_t> small(1'000, 32);
+    small[500] = 56;
+    auto column = column_codec::Column<uint64_t>::encode(
+        small, column_codec::Encoding::frame_of_reference);
+    auto raw_bytes = small.size() * sizeof(uint64_t);
+    auto compressed_bytes = column.compressed_bytes();
+    PRINT_VAR(raw_bytes)
+    PRINT_VAR(compressed_bytes)
+    PRINT_VAR(column[500])
+
+    println("\nsigned columns, values in [-5, 5]:");
+    signed_round_trip<int8_t>("int8_t");
+    signed_round_trip<int16_t>("int16_t");
+    signed_round_trip<int32_t>("int32_t");
+    signed_round_trip<int64_t>("int64_t");
+
+    println("\n{} uint64_t values per column", num_values);
+    mt19937_64 rng{10};
+    vector<uint64_t> values(num_values);
+
+    uniform_int_distribution<uint64_t> status{0, 999};
+    for (auto &v : values) {
+        v = status(rng);
+    }
+    run("values in [0, 1000), frame of reference", values,
+        column_codec::Encoding::frame_of_reference);
+
+    // microsecond timestamps, ~1 event every 0-100 us
+    uint64_t now = 1'700'000'000'000'000;
+    uniform_int_distribution<uint64_t> gap{0, 100};
+    for (auto &v : values) {
+        now += gap(rng);
+        v = now;
+    }
+    run("sorted timestamps, frame of reference", values,
+        column_codec::Encoding::frame_of_reference);
+    run("sorted timestamps, delta", values, column_codec::Encoding::delta);
+
+    // incompressible: every block needs all 64 bits
+    for (auto &v : values) {
+        v = rng();
+    }
+    run("random 64-bit values, frame of reference", values,
+        column_codec::Encoding::frame_of_reference);
+}
@@ -0,0 +1,310 @@
+#pragma once
+
+// Flat containers indexed by an enum
+//
+// Data keyed by a small enum (`enum class Color : std::uint8_t { BLACK,
+// BLUE, GREEN }`) doesn't need a hash table: the enumerators already are
+// dense indices 0..N-1. What's missing is N, and the names, which C++
+// (before reflection) doesn't expose. They are recovered at compile time
+// from the compiler's pretty function name for `template <auto V>`
+// instantiations (gcc: "... [with auto V = Color::BLUE]", clang: "[V =
+// Color::BLUE]"), where a value without an enumerator prints as a cast
+// ("(Color)3"):
+//   - `enum_count<E>` - number of consecutive enumerators from 0 (scanned up
+//     to `max_enumerators`)
+//   - `enum_names<E>` / `to_string(e)` / `from_string<E>(s)` - constexpr
+//     name tables
+//
+// With those:
+//   - `EnumArray<E, T>` - a `std::array<T, enum_count<E>>` indexed by `E`
+//   - `EnumSet<E>` - one bit per enumerator in 64-bit words; `size()` is a
+//     popcount, and iteration jumps from set bit to set bit (count trailing
+//     zeros, clear the lowest bit) instead of testing every enumerator
+// Neither hashes nor allocates, and both are usable in constant expressions.
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace enum_container {
+
+// Enums with a fixed underlying type (`enum class E : std::uint8_t`): only
+// those may hold every value the scan below casts to
+template <typename E>
+concept enumeration = std::is_enum_v<E> && requires { E{0}; };
+
+// Enumerators are looked for in [0, max_enumerators)
+inline constexpr std::size_t max_enumerators = 256;
+
+namespace detail {
+
+template <auto V> constexpr auto pretty_name() -> std::string_view {
+    return __PRETTY_FUNCTION__;
+}
+
+// Unqualified enumerator name of `V`, or "" if `V` has none
+template <auto V> constexpr auto enumerator_name() -> std::string_view {
+    std::string_view name = pretty_name<V>();
+    auto value = name.rfind("V = ");
+    if (value == std::string_view::npos) {
+        return {};
+    }
+    name.remove_prefix(value + 4);
+    name = name.substr(0, name.find_first_of("];"));
+    if (name.empty() || name.front() == '(') {
+        return {}; // printed as a cast: no enumerator
+    }
+    if (auto scope = name.rfind("::"); scope != std::string_view::npos) {
+        name.remove_prefix(scope + 2);
+    }
+    return name;
+}
+
+template <enumeration E, std::size_t... I>
+constexpr auto count_enumerators(std::index_sequence<I...>) -> std::size_t {
+    constexpr std::array<bool, sizeof...(I)> named{
+        !enumerator_name<static_cast<E>(I)>().empty()...};
+    return static_cast<std::size_t>(std::ranges::find(named, false) -
+                                    named.begin());
+}
+
+template <enumeration E>
+constexpr auto max_scanned() -> std::size_t {
+    using U = std::underlying_type_t<E>;
+    if constexpr (sizeof(U) == 1 && std::is_signed_v<U>) {
+        return 128; // (E)128 would not be representable
+    } else {
+        return max_enumerators;
+    }
+}
+
+} // namespace detail
+
+template <enumeration E>
+inline constexpr std::size_t enum_count = detail::count_enumerators<E>(
+    std::make_index_sequence<detail::max_scanned<E>()>{});
+
+template <enumeration E>
+inline constexpr auto enum_names =
+    []<std::size_t... I>(std::index_sequence<I...>) {
+        return std::array<std::string_view, sizeof...(I)>{
+            detail::enumerator_name<static_cast<E>(I)>()...};
+    }(std::make_index_sequence<enum_count<E>>{});
+
+template <enumeration E>
+inline constexpr auto enum_values =
+    []<std::size_t... I>(std::index_sequence<I...>) {
+        return std::array<E, sizeof...(I)>{static_cast<E>(I)...};
+    }(std::make_index_sequence<enum_count<E>>{});
+
+template <enumeration E> constexpr auto to_index(E e) -> std::size_t {
+    return static_cast<std::size_t>(
+        static_cast<std::underlying_type_t<E>>(e));
+}
+
+// "" for values without an enumerator
+template <enumeration E> constexpr auto to_string(E e) -> std::string_view {
+    auto i = to_index(e);
+    return i < enum_count<E> ? enum_names<E>[i] : std::string_view{};
+}
+
+template <enumeration E>
+constexpr auto from_string(std::string_view name) -> std::optional<E> {
+    for (std::size_t i = 0; i < enum_count<E>; i++) {
+        if (enum_names<E>[i] == name) {
+            return static_cast<E>(i);
+        }
+    }
+    return std::nullopt;
+}
+
+// ===== EnumArray =====
+
+template <enumeration E, typename T> class EnumArray {
+  public:
+    static constexpr std::size_t extent = enum_count<E>;
+    static_assert(extent > 0, "no enumerators found from 0");
+
+    constexpr EnumArray() = default;
+    constexpr explicit EnumArray(const T &value) { values_.fill(value); }
+
+    constexpr auto operator[](E e) -> T & { return values_[to_index(e)]; }
+    constexpr auto operator[](E e) const -> const T & {
+        return values_[to_index(e)];
+    }
+
+    constexpr auto at(E e) -> T & { return values_.at(to_index(e)); }
+    constexpr auto at(E e) const -> const T & {
+        return values_.at(to_index(e));
+    }
+
+    [[nodiscard]] static constexpr auto size() -> std::size_t {
+        return extent;
+    }
+
+    // Values in enumerator order
+    constexpr auto begin() { return values_.begin(); }
+    constexpr auto end() { return values_.end(); }
+    constexpr auto begin() const { return values_.begin(); }
+    constexpr auto end() const { return values_.end(); }
+
+    // `f(E, T &)` for every enumerator
+    template <typename F> constexpr void for_each(F &&f) {
+        for (std::size_t i = 0; i < extent; i++) {
+            f(static_cast<E>(i), values_[i]);
+        }
+    }
+
+    constexpr auto operator==(const EnumArray &) const -> bool = default;
+
+  private:
+    std::array<T, extent> values_{};
+};
+
+// ===== EnumSet =====
+
+template <enumeration E> class EnumSet {
+    static constexpr std::size_t num_words = (enum_count<E> + 63) / 64;
+
+  public:
+    class Iterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = E;
+        using difference_type = std::ptrdiff_t;
+
+        constexpr Iterator() = default;
+
+        constexpr auto operator*() const -> E {
+            return static_cast<E>(
+                (word_ * 64) +
+                static_cast<std::size_t>(std::countr_zero(bits_)));
+        }
+        constexpr auto operator++() -> Iterator & {
+            bits_ &= bits_ - 1; // clear the lowest set bit
+            skip_empty();
+            return *this;
+        }
+        constexpr auto operator++(int) -> Iterator {
+            auto old = *this;
+            ++*this;
+            return old;
+        }
+        constexpr auto operator==(const Iterator &other) const -> bool {
+            return word_ == other.word_ && bits_ == other.bits_;
+        }
+
+      private:
+        friend class EnumSet;
+
+        constexpr Iterator(const std::array<std::uint64_t, num_words> *words,
+                           std::size_t word)
+            : words_{words}, word_{word},
+              bits_{word < num_words ? (*words)[word] : 0} {
+            skip_empty();
+        }
+
+        constexpr void skip_empty() {
+            while (bits_ == 0 && word_ < num_words) {
+                word_++;
+                bits_ = word_ < num_words ? (*words_)[word_] : 0;
+            }
+        }
+
+        const std::array<std::uint64_t, num_words> *words_ = nullptr;
+        std::size_t word_ = num_words;
+        std::uint64_t bits_ = 0;
+    };
+
+    constexpr EnumSet() = default;
+    constexpr EnumSet(std::initializer_list<E> values) {
+        for (auto e : values) {
+            insert(e);
+        }
+    }
+
+    static constexpr auto all() -> EnumSet {
+        EnumSet set;
+        set.words_.fill(~std::uint64_t{0});
+        set.trim();
+        return set;
+    }
+
+    constexpr void insert(E e) { words_[word(e)] |= bit(e); }
+    constexpr void erase(E e) { words_[word(e)] &= ~bit(e); }
+    [[nodiscard]] constexpr auto contains(E e) const -> bool {
+        return (words_[word(e)] & bit(e)) != 0;
+    }
+    constexpr void clear() { words_.fill(0); }
+
+    [[nodiscard]] constexpr auto size() const -> std::size_t {
+        std::size_t n = 0;
+        for (auto w : words_) {
+            n += static_cast<std::size_t>(std::popcount(w));
+        }
+        return n;
+    }
+    [[nodiscard]] constexpr auto empty() const -> bool {
+        return std::ranges::all_of(words_, [](auto w) { return w == 0; });
+    }
+
+    constexpr auto begin() const -> Iterator { return {&words_, 0}; }
+    constexpr auto end() const -> Iterator { return {&words_, num_words}; }
+
+    constexpr auto operator|=(const EnumSet &other) -> EnumSet & {
+        for (std::size_t i = 0; i < num_words; i++) {
+            words_[i] |= other.words_[i];
+        }
+        return *this;
+    }
+    constexpr auto operator&=(const EnumSet &other) -> EnumSet & {
+        for (std::size_t i = 0; i < num_words; i++) {
+            words_[i] &= other.words_[i];
+        }
+        return *this;
+    }
+    friend constexpr auto operator|(EnumSet a, const EnumSet &b) -> EnumSet {
+        return a |= b;
+    }
+    friend constexpr auto operator&(EnumSet a, const EnumSet &b) -> EnumSet {
+        return a &= b;
+    }
+    // Complement within the enumerators
+    constexpr auto operator~() const -> EnumSet {
+        EnumSet set;
+        for (std::size_t i = 0; i < num_words; i++) {
+            set.words_[i] = ~words_[i];
+        }
+        set.trim();
+        return set;
+    }
+
+    constexpr auto operator==(const EnumSet &) const -> bool = default;
+
+  private:
+    static constexpr auto word(E e) -> std::size_t { return to_index(e) / 64; }
+    static constexpr auto bit(E e) -> std::uint64_t {
+        return std::uint64_t{1} << (to_index(e) % 64);
+    }
+
+    // Clear the bits past the last enumerator
+    constexpr void trim() {
+        if constexpr (enum_count<E> % 64 != 0) {
+            words_[num_words - 1] &=
+                (std::uint64_t{1} << (enum_count<E> % 64)) - 1;
+        }
+    }
+
+    std::array<std::uint64_t, num_words> words_{};
+};
+
+} // namespace enum_container
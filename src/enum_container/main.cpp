@@ -0,0 +1,168 @@
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <print>
+#include <random>
+#include <set>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "enum_container/enum_container.hpp"
+
+using namespace std;
+
+#define PRINT_VAR(var) std::println("{} = {}", #var, var);
+
+constexpr size_t num_lookups = 20'000'000;
+constexpr size_t num_sets = 200'000;
+constexpr int reps = 5;
+
+// basic_concepts_iii
+enum class Color : uint8_t { BLACK, BLUE, GREEN };
+
+enum class Permission : uint8_t {
+    read,
+    write,
+    execute,
+    create,
+    remove,
+    list,
+    rename,
+    chmod,
+    chown,
+    link,
+    mount,
+    admin,
+    audit,
+    backup,
+    restore,
+    share
+};
+
+using enum_container::EnumArray;
+using enum_container::EnumSet;
+
+void bench_lookup() {
+    println("\n{} lookups of a random Color:", num_lookups);
+    mt19937 rng{16};
+    vector<Color> keys(num_lookups);
+    for (auto &k : keys) {
+        k = static_cast<Color>(rng() % enum_container::enum_count<Color>);
+    }
+
+    EnumArray<Color, int64_t> array;
+    unordered_map<Color, int64_t> hash_map;
+    map<Color, int64_t> tree_map;
+    for (auto c : enum_container::enum_values<Color>) {
+        auto v = static_cast<int64_t>(enum_container::to_index(c)) + 1;
+        array[c] = v;
+        hash_map[c] = v;
+        tree_map[c] = v;
+    }
+
+    auto lookup = [&](const char *label, const auto &container) {
+        int64_t sum = 0;
+        auto t = bench::time_best(reps, [&] {
+            sum = 0;
+            for (auto k : keys) {
+                sum += container.at(k);
+            }
+        });
+        bench::report(label, t, num_lookups, "lookups");
+        return sum;
+    };
+    auto expected = lookup("std::map", tree_map);
+    auto hashed = lookup("std::unordered_map", hash_map);
+    auto flat = lookup("EnumArray", array);
+    println("  sums match: {}", expected == hashed && flat == hashed);
+}
+
+// Popcount iteration does work per member; testing every enumerator does
+// work per enumerator, but with a fixed trip count the compiler unrolls
+// (so it only loses once sets are sparse relative to the enum)
+void bench_iteration(unsigned one_in) {
+    println("\nvisit every member of {} Permission sets (16 flags, each set "
+            "with probability 1/{}):",
+            num_sets, one_in);
+    mt19937 rng{17};
+    vector<EnumSet<Permission>> enum_sets(num_sets);
+    vector<unordered_set<Permission>> hash_sets(num_sets);
+    vector<set<Permission>> tree_sets(num_sets);
+    size_t members = 0;
+    for (size_t i = 0; i < num_sets; i++) {
+        for (auto p : enum_container::enum_values<Permission>) {
+            if (rng() % one_in == 0) {
+                enum_sets[i].insert(p);
+                hash_sets[i].insert(p);
+                tree_sets[i].insert(p);
+                members++;
+            }
+        }
+    }
+
+    auto visit_all = [&](const char *label, const auto &sets) {
+        size_t sum = 0;
+        auto t = bench::time_best(reps, [&] {
+            sum = 0;
+            for (const auto &s : sets) {
+                for (auto p : s) {
+                    sum += enum_container::to_index(p);
+                }
+            }
+        });
+        bench::report(label, t, static_cast<double>(members), "members");
+        return sum;
+    };
+    auto expected = visit_all("std::set", tree_sets);
+    auto hashed = visit_all("std::unordered_set", hash_sets);
+    auto flat = visit_all("EnumSet (popcount iteration)", enum_sets);
+
+    // the same bits, testing every enumerator
+    size_t tested = 0;
+    auto t = bench::time_best(reps, [&] {
+        tested = 0;
+        for (const auto &s : enum_sets) {
+            for (auto p : enum_container::enum_values<Permission>) {
+                if (s.contains(p)) {
+                    tested += enum_container::to_index(p);
+                }
+            }
+        }
+    });
+    bench::report("EnumSet (test every enumerator)", t,
+                  static_cast<double>(members), "members");
+    println("  sums match: {}",
+            expected == hashed && flat == hashed && tested == flat);
+}
+
+auto main() -> int {
+    println("Enum container - enum-indexed arrays and bit sets");
+
+    println("\nbasic_concepts_iii Color, introspected:");
+    constexpr auto color_count = enum_container::enum_count<Color>;
+    PRINT_VAR(color_count)
+    PRINT_VAR(enum_container::to_string(Color::BLUE))
+    PRINT_VAR(enum_container::from_string<Color>("GREEN").has_value())
+    EnumArray<Color, string_view> hex;
+    hex[Color::BLACK] = "#000000";
+    hex[Color::BLUE] = "#0000ff";
+    hex[Color::GREEN] = "#00ff00";
+    for (auto c : enum_container::enum_values<Color>) {
+        println("{} = {}", enum_container::to_string(c), hex[c]);
+    }
+    auto sizeof_hex = sizeof(hex);
+    PRINT_VAR(sizeof_hex)
+    EnumSet<Permission> perms{Permission::read, Permission::list,
+                              Permission::share};
+    PRINT_VAR(perms.size())
+    PRINT_VAR((~perms).size())
+    auto sizeof_perms = sizeof(perms);
+    PRINT_VAR(sizeof_perms)
+
+    bench_lookup();
+    bench_iteration(2);
+    bench_iteration(16);
+}
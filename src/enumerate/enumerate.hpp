@@ -0,0 +1,150 @@
+#pragma once
+
+// Index + element views
+//
+// `std::views::enumerate` is C++23 and not in every standard library yet;
+// the usual stand-ins (a second loop variable, `views::zip(views::iota(0),
+// v)`) either leave the counter to the caller or go through zip's tuple of
+// iterators, which optimizers don't always see through.
+//
+// `enumerate::enumerate(range)` yields `{index, element}` pairs:
+//   - `for (auto [i, x] : enumerate(v))` - `x` is a reference to the
+//     element, so it can be assigned through
+//   - contiguous ranges (vector, array, span, ...): the iterator is a data
+//     pointer plus the index, and `*it` is `data[index]`, so the loop is the
+//     same counted loop as `for (i = 0; i != n; i++) ... v[i]` - and it
+//     auto-vectorizes the same way
+//   - other ranges: the iterator is the range's iterator plus a counter
+//
+// The index type defaults to `std::size_t`; `enumerate<int>(v)` matches the
+// `int i` of a hand-written loop.
+
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <utility>
+
+namespace enumerate {
+
+// `auto [index, value]`; `value` is the range's reference type
+template <typename Index, typename Ref> struct Indexed {
+    Index index;
+    Ref value;
+};
+
+// ===== Contiguous ranges =====
+
+template <typename T, std::integral Index>
+class ContiguousView
+    : public std::ranges::view_interface<ContiguousView<T, Index>> {
+  public:
+    class Iterator {
+      public:
+        using value_type = Indexed<Index, T &>;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+        Iterator(T *data, Index index) : data_{data}, index_{index} {}
+
+        auto operator*() const -> value_type {
+            return {index_, data_[index_]};
+        }
+        auto operator++() -> Iterator & {
+            ++index_;
+            return *this;
+        }
+        auto operator++(int) -> Iterator {
+            auto old = *this;
+            ++index_;
+            return old;
+        }
+        // only the index moves; both ends share `data`
+        auto operator==(const Iterator &other) const -> bool {
+            return index_ == other.index_;
+        }
+
+      private:
+        T *data_ = nullptr;
+        Index index_ = 0;
+    };
+
+    ContiguousView() = default;
+    ContiguousView(T *data, Index size) : data_{data}, size_{size} {}
+
+    [[nodiscard]] auto begin() const -> Iterator { return {data_, 0}; }
+    [[nodiscard]] auto end() const -> Iterator { return {data_, size_}; }
+    [[nodiscard]] auto size() const -> std::size_t {
+        return static_cast<std::size_t>(size_);
+    }
+
+  private:
+    T *data_ = nullptr;
+    Index size_ = 0;
+};
+
+// ===== Any other range =====
+
+template <std::ranges::input_range R, std::integral Index>
+class CountingView
+    : public std::ranges::view_interface<CountingView<R, Index>> {
+    using Base = std::ranges::iterator_t<R>;
+    using BaseSentinel = std::ranges::sentinel_t<R>;
+
+  public:
+    class Iterator {
+      public:
+        using value_type = Indexed<Index, std::ranges::range_reference_t<R>>;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+        Iterator(Base it, Index index) : it_{std::move(it)}, index_{index} {}
+
+        auto operator*() const -> value_type { return {index_, *it_}; }
+        auto operator++() -> Iterator & {
+            ++it_;
+            ++index_;
+            return *this;
+        }
+        auto operator++(int) -> Iterator {
+            auto old = *this;
+            ++*this;
+            return old;
+        }
+        auto operator==(const BaseSentinel &end) const -> bool {
+            return it_ == end;
+        }
+
+      private:
+        Base it_{};
+        Index index_ = 0;
+    };
+
+    CountingView() = default;
+    explicit CountingView(R &range)
+        : first_{std::ranges::begin(range)}, last_{std::ranges::end(range)} {}
+
+    [[nodiscard]] auto begin() const -> Iterator { return {first_, 0}; }
+    [[nodiscard]] auto end() const -> BaseSentinel { return last_; }
+
+  private:
+    Base first_{};
+    BaseSentinel last_{};
+};
+
+// Enumerate a range that outlives the loop (any lvalue range)
+template <std::integral Index = std::size_t, std::ranges::range R>
+    requires std::ranges::borrowed_range<R>
+auto enumerate(R &&range) {
+    if constexpr (std::ranges::contiguous_range<R> &&
+                  std::ranges::sized_range<R>) {
+        using T = std::remove_reference_t<std::ranges::range_reference_t<R>>;
+        return ContiguousView<T, Index>{
+            std::ranges::data(range),
+            static_cast<Index>(std::ranges::size(range))};
+    } else {
+        return CountingView<std::remove_reference_t<R>, Index>{range};
+    }
+}
+
+} // namespace enumerate
@@ -0,0 +1,148 @@
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <print>
+#include <ranges>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "enumerate/enumerate.hpp"
+
+using namespace std;
+
+#define PRINT_VAR(var) std::println("{} = {}", #var, var);
+
+// Same number of elements visited per size: a cache-resident vector many
+// times, then one that only fits in memory
+constexpr size_t elements_per_run = size_t{1} << 26;
+constexpr int reps = 5;
+
+// One kernel per form, each `sum += i * v[i]` (unsigned, so wrapping is
+// defined and the compiler is free to vectorize the reduction)
+// - noinline so each shows up as its own symbol: compare the generated code
+//   with `objdump -d --no-show-raw-insn -C enumerate_bench` (or build with
+//   `-fopt-info-vec` / `-Rpass=loop-vectorize` to see which loops vectorize)
+// - the index width matters more than the form: a `size_t` index is
+//   widened in 64-bit lanes, half as many per vector as an `int` one
+
+[[gnu::noinline]] auto raw_index(const vector<uint32_t> &vec) -> uint32_t {
+    uint32_t sum = 0;
+    for (size_t i = 0; i < vec.size(); i++) {
+        sum += static_cast<uint32_t>(i) * vec[i];
+    }
+    return sum;
+}
+
+[[gnu::noinline]] auto tuple_iterator(const vector<uint32_t> &vec)
+    -> uint32_t {
+    uint32_t sum = 0;
+    for (auto [it, i] = tuple{vec.begin(), 0}; it != vec.end(); it++, i++) {
+        sum += static_cast<uint32_t>(i) * *it;
+    }
+    return sum;
+}
+
+[[gnu::noinline]] auto range_for_init(const vector<uint32_t> &vec)
+    -> uint32_t {
+    uint32_t sum = 0;
+    for (int i = 0; auto val : vec) {
+        sum += static_cast<uint32_t>(i) * val;
+        i++;
+    }
+    return sum;
+}
+
+[[gnu::noinline]] auto zip_iota(const vector<uint32_t> &vec) -> uint32_t {
+    uint32_t sum = 0;
+    for (auto [i, val] : views::zip(views::iota(0), vec)) {
+        sum += static_cast<uint32_t>(i) * val;
+    }
+    return sum;
+}
+
+[[gnu::noinline]] auto enumerate_view(const vector<uint32_t> &vec)
+    -> uint32_t {
+    uint32_t sum = 0;
+    for (auto [i, val] : enumerate::enumerate(vec)) {
+        sum += static_cast<uint32_t>(i) * val;
+    }
+    return sum;
+}
+
+[[gnu::noinline]] auto enumerate_int(const vector<uint32_t> &vec)
+    -> uint32_t {
+    uint32_t sum = 0;
+    for (auto [i, val] : enumerate::enumerate<int>(vec)) {
+        sum += static_cast<uint32_t>(i) * val;
+    }
+    return sum;
+}
+
+void bench_forms(size_t size) {
+    auto rounds = elements_per_run / size;
+    println("\nsum of i * vec[i], vector<uint32_t> of {} elements ({} KiB), "
+            "{} rounds:",
+            size, size * sizeof(uint32_t) / 1024, rounds);
+    vector<uint32_t> vec(size);
+    for (size_t i = 0; i < size; i++) {
+        vec[i] = static_cast<uint32_t>((i * 2654435761U) >> 7);
+    }
+
+    auto run = [&](const char *label, auto kernel) {
+        uint32_t total = 0;
+        auto t = bench::time_best(reps, [&] {
+            total = 0;
+            for (size_t r = 0; r < rounds; r++) {
+                bench::do_not_optimize(vec);
+                total += kernel(vec);
+            }
+        });
+        bench::report(label, t, static_cast<double>(rounds * size),
+                      "elements");
+        return total;
+    };
+    auto expected = run("raw index loop", raw_index);
+    auto tuple_total = run("tuple{begin, 0} iterator loop", tuple_iterator);
+    auto init_total = run("range-for with int i init", range_for_init);
+    auto zip_total = run("views::zip(views::iota(0), vec)", zip_iota);
+    auto enum_total = run("enumerate(vec)", enumerate_view);
+    auto enum_int_total = run("enumerate<int>(vec)", enumerate_int);
+    println("  sums match: {}", tuple_total == expected &&
+                                    init_total == expected &&
+                                    zip_total == expected &&
+                                    enum_total == expected &&
+                                    enum_int_total == expected);
+}
+
+auto main() -> int {
+    println("Enumerate - index + element views");
+
+    // basic_concepts_iii, without the hand-kept counter
+    println("\nEnumerating:");
+    vector vec{1, 2, 3, 4};
+    for (auto [i, val] : enumerate::enumerate(vec)) {
+        println("idx {}: {}", i, val);
+    }
+    // the element is a reference
+    for (auto [i, val] : enumerate::enumerate(vec)) {
+        val *= static_cast<int>(i);
+    }
+    for (auto [i, val] : enumerate::enumerate<int>(vec)) {
+        println("idx {}: {}", i, val);
+    }
+    // not contiguous: the list iterator plus a counter
+    list<string> names{"x", "y", "z"};
+    for (auto [i, name] : enumerate::enumerate(names)) {
+        println("idx {}: {}", i, name);
+    }
+    auto sizeof_contiguous_iterator =
+        sizeof(enumerate::enumerate(vec).begin());
+    auto sizeof_list_iterator = sizeof(enumerate::enumerate(names).begin());
+    PRINT_VAR(sizeof_contiguous_iterator)
+    PRINT_VAR(sizeof_list_iterator)
+
+    bench_forms(size_t{1} << 12);
+    bench_forms(size_t{1} << 24);
+}
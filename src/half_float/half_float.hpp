@@ -0,0 +1,212 @@
+#pragma once
+
+// 16-bit floating-point storage with float compute
+//
+// When a kernel is bound by memory bandwidth, halving the bytes per element
+// matters more than the arithmetic. These types only *store* 16 bits; all
+// arithmetic converts to float, accumulates in float, and (for `axpy`) rounds
+// back to 16 bits on store:
+//   - `bfloat16` - float's 8-bit exponent, 7-bit mantissa: same range as
+//                  float, ~2-3 significant digits; conversion is a shift
+//   - `float16`  - IEEE binary16: 5-bit exponent (max 65504), 10-bit mantissa
+//
+// Both round to nearest-even and keep NaN and infinity; the bit layouts
+// match C++23 `std::bfloat16_t` / `std::float16_t` (<stdfloat>), which not
+// every compiler/target provides yet.
+//
+// The conversions are branchless (bitwise selects instead of ifs), so the
+// bulk loops below auto-vectorize; the kernels convert 256-element blocks
+// into a float buffer on the stack and run `std::experimental::simd` over
+// that.
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <experimental/simd>
+#include <span>
+
+namespace half_float {
+
+namespace stdx = std::experimental;
+
+namespace detail {
+
+// `c ? a : b` as bit operations; plain ternaries here end up as branches,
+// which stop the bulk loops from vectorizing
+constexpr auto select(bool c, std::uint32_t a, std::uint32_t b)
+    -> std::uint32_t {
+    return b ^ ((a ^ b) & (0U - static_cast<std::uint32_t>(c)));
+}
+
+} // namespace detail
+
+struct bfloat16 {
+    std::uint16_t bits;
+
+    static constexpr auto from_float(float f) -> bfloat16 {
+        auto u = std::bit_cast<std::uint32_t>(f);
+        // round to nearest-even on the 16 dropped bits
+        auto rounded = u + 0x7FFFU + ((u >> 16U) & 1U);
+        // NaN: keep it a (quiet) NaN rather than letting rounding carry it
+        // into infinity
+        bool nan = (u & 0x7FFF'FFFFU) > 0x7F80'0000U;
+        return {static_cast<std::uint16_t>(
+            detail::select(nan, (u >> 16U) | 0x40U, rounded >> 16U))};
+    }
+
+    [[nodiscard]] constexpr auto to_float() const -> float {
+        return std::bit_cast<float>(std::uint32_t{bits} << 16U);
+    }
+};
+
+struct float16 {
+    std::uint16_t bits;
+
+    // After F. Giesen's float_to_half_fast3_rtne
+    static constexpr auto from_float(float f) -> float16 {
+        constexpr std::uint32_t f32_infinity = 255U << 23U;
+        constexpr std::uint32_t f16_overflow = (127U + 16U) << 23U;
+        constexpr std::uint32_t f16_min_normal = 113U << 23U;
+        // adding this float shifts a denormal's mantissa into place, rounded
+        constexpr std::uint32_t denorm_magic =
+            ((127U - 15U) + (23U - 10U) + 1U) << 23U;
+
+        auto u = std::bit_cast<std::uint32_t>(f);
+        auto sign = u & 0x8000'0000U;
+        u ^= sign;
+
+        // |f| >= 65520: infinity, or a quiet NaN
+        auto overflow = detail::select(u > f32_infinity, 0x7E00U, 0x7C00U);
+        // |f| < 2^-14: denormal or zero
+        auto denormal =
+            std::bit_cast<std::uint32_t>(std::bit_cast<float>(u) +
+                                         std::bit_cast<float>(denorm_magic)) -
+            denorm_magic;
+        // normal: rebias the exponent, round to nearest-even
+        auto mantissa_odd = (u >> 13U) & 1U;
+        auto normal =
+            (u + ((15U - 127U) << 23U) + 0xFFFU + mantissa_odd) >> 13U;
+
+        auto h = detail::select(
+            u >= f16_overflow, overflow,
+            detail::select(u < f16_min_normal, denormal, normal));
+        return {static_cast<std::uint16_t>(h | (sign >> 16U))};
+    }
+
+    // After F. Giesen's half_to_float
+    [[nodiscard]] constexpr auto to_float() const -> float {
+        constexpr std::uint32_t shifted_exp = 0x7C00U << 13U;
+        constexpr float magic = std::bit_cast<float>(113U << 23U);
+
+        std::uint32_t u = (std::uint32_t{bits} & 0x7FFFU) << 13U;
+        auto exp = u & shifted_exp;
+        u += (127U - 15U) << 23U;
+
+        auto inf_nan = u + ((128U - 16U) << 23U);
+        auto denormal = std::bit_cast<std::uint32_t>(
+            std::bit_cast<float>(u + (1U << 23U)) - magic);
+        u = detail::select(exp == shifted_exp, inf_nan,
+                           detail::select(exp == 0, denormal, u));
+        return std::bit_cast<float>(u | ((std::uint32_t{bits} & 0x8000U)
+                                         << 16U));
+    }
+};
+
+template <typename H>
+concept storage16 = std::same_as<H, bfloat16> || std::same_as<H, float16>;
+
+// ===== Bulk conversion =====
+
+template <storage16 H>
+void to_float(std::span<const H> in, std::span<float> out) {
+    for (std::size_t i = 0; i < in.size(); i++) {
+        out[i] = in[i].to_float();
+    }
+}
+
+template <storage16 H>
+void from_float(std::span<const float> in, std::span<H> out) {
+    for (std::size_t i = 0; i < in.size(); i++) {
+        out[i] = H::from_float(in[i]);
+    }
+}
+
+// ===== Kernels (float accumulation) =====
+
+inline constexpr std::size_t block_size = 256;
+
+namespace detail {
+
+using floatv = stdx::native_simd<float>;
+
+// Convert a block of up to `block_size` values onto the stack, then hand the
+// float view to `fn`
+template <storage16 H, typename F>
+void for_each_block(std::span<const H> values, F fn) {
+    alignas(stdx::memory_alignment_v<floatv>) std::array<float, block_size> buf;
+    for (std::size_t i = 0; i < values.size(); i += block_size) {
+        auto n = std::min(block_size, values.size() - i);
+        to_float(values.subspan(i, n), std::span{buf}.first(n));
+        fn(i, std::span<const float>{buf}.first(n));
+    }
+}
+
+} // namespace detail
+
+template <storage16 H> //
+auto sum(std::span<const H> values) -> float {
+    detail::floatv acc = 0;
+    float tail = 0;
+    detail::for_each_block(values, [&](std::size_t, std::span<const float> x) {
+        std::size_t j = 0;
+        for (; j + detail::floatv::size() <= x.size();
+             j += detail::floatv::size()) {
+            acc += detail::floatv{x.data() + j, stdx::vector_aligned};
+        }
+        for (; j < x.size(); j++) {
+            tail += x[j];
+        }
+    });
+    return stdx::reduce(acc) + tail;
+}
+
+template <storage16 H>
+auto dot(std::span<const H> a, std::span<const H> b) -> float {
+    alignas(stdx::memory_alignment_v<detail::floatv>)
+        std::array<float, block_size> bbuf;
+    detail::floatv acc = 0;
+    float tail = 0;
+    detail::for_each_block(a, [&](std::size_t i, std::span<const float> x) {
+        to_float(b.subspan(i, x.size()), std::span{bbuf}.first(x.size()));
+        std::size_t j = 0;
+        for (; j + detail::floatv::size() <= x.size();
+             j += detail::floatv::size()) {
+            acc += detail::floatv{x.data() + j, stdx::vector_aligned} *
+                   detail::floatv{bbuf.data() + j, stdx::vector_aligned};
+        }
+        for (; j < x.size(); j++) {
+            tail += x[j] * bbuf[j];
+        }
+    });
+    return stdx::reduce(acc) + tail;
+}
+
+// y = alpha * x + y, computed in float and rounded back to `H`
+template <storage16 H>
+void axpy(float alpha, std::span<const H> x, std::span<H> y) {
+    alignas(stdx::memory_alignment_v<detail::floatv>)
+        std::array<float, block_size> ybuf;
+    detail::for_each_block(x, [&](std::size_t i, std::span<const float> xf) {
+        auto yf = std::span{ybuf}.first(xf.size());
+        to_float(std::span<const H>{y.subspan(i, xf.size())}, yf);
+        for (std::size_t j = 0; j < xf.size(); j++) {
+            yf[j] = (alpha * xf[j]) + yf[j];
+        }
+        from_float(std::span<const float>{yf}, y.subspan(i, xf.size()));
+    });
+}
+
+} // namespace half_float
@@ -0,0 +1,121 @@
+#include <cstddef>
+#include <print>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "half_float/half_float.hpp"
+
+using namespace std;
+
+#define PRINT_VAR(var) std::println("{} = {}", #var, var);
+
+constexpr size_t num_values = 32'000'000;
+constexpr int reps = 5;
+
+using half_float::bfloat16;
+using half_float::float16;
+
+// Plain float/double versions of the kernels, for comparison
+template <typename T> //
+auto sum(span<const T> x) -> T {
+    T acc = 0;
+    for (T v : x) {
+        acc += v;
+    }
+    return acc;
+}
+template <typename T> //
+auto dot(span<const T> a, span<const T> b) -> T {
+    T acc = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        acc += a[i] * b[i];
+    }
+    return acc;
+}
+template <typename T> //
+void axpy(T alpha, span<const T> x, span<T> y) {
+    for (size_t i = 0; i < x.size(); i++) {
+        y[i] = (alpha * x[i]) + y[i];
+    }
+}
+
+// GB/s of array traffic, counting `arrays_touched` arrays of `elem_size`
+void report(const char *name, double t, size_t elem_size,
+            size_t arrays_touched) {
+    auto bytes = static_cast<double>(num_values * elem_size * arrays_touched);
+    println("  {:<20} {:>8.2f} ms  {:>7.2f} GB/s", name, t * 1e3,
+            bytes / t / 1e9);
+}
+
+template <typename T, typename Sum, typename Dot, typename Axpy>
+void run(const char *name, vector<T> &x, vector<T> &y, Sum sum_fn,
+         Dot dot_fn, Axpy axpy_fn) {
+    span<const T> cx{x};
+    span<const T> cy{y};
+    auto t =
+        bench::time_best(reps, [&] { bench::do_not_optimize(sum_fn(cx)); });
+    report(format("{} sum", name).c_str(), t, sizeof(T), 1);
+    t = bench::time_best(reps,
+                         [&] { bench::do_not_optimize(dot_fn(cx, cy)); });
+    report(format("{} dot", name).c_str(), t, sizeof(T), 2);
+    // read x and y, write y
+    t = bench::time_best(reps, [&] {
+        axpy_fn(1e-3F, cx, span<T>{y});
+        bench::clobber_memory();
+    });
+    report(format("{} axpy", name).c_str(), t, sizeof(T), 3);
+}
+
+auto main() -> int {
+    println("Half Float - 16-bit storage, float compute");
+
+    println("\nround trips:");
+    PRINT_VAR(bfloat16::from_float(3.14159F).to_float())
+    PRINT_VAR(float16::from_float(3.14159F).to_float())
+    PRINT_VAR(float16::from_float(70'000.0F).to_float()) // overflows to inf
+    PRINT_VAR(bfloat16::from_float(70'000.0F).to_float())
+
+    mt19937 rng{9};
+    uniform_real_distribution<float> dist{-1.0F, 1.0F};
+    vector<float> xf(num_values);
+    vector<float> yf(num_values);
+    for (size_t i = 0; i < num_values; i++) {
+        xf[i] = dist(rng);
+        yf[i] = dist(rng);
+    }
+    vector<double> xd(xf.begin(), xf.end());
+    vector<double> yd(yf.begin(), yf.end());
+    vector<bfloat16> xb(num_values);
+    vector<bfloat16> yb(num_values);
+    half_float::from_float<bfloat16>(xf, xb);
+    half_float::from_float<bfloat16>(yf, yb);
+    vector<float16> xh(num_values);
+    vector<float16> yh(num_values);
+    half_float::from_float<float16>(xf, xh);
+    half_float::from_float<float16>(yf, yh);
+
+    println("\n{} elements per array:", num_values);
+    run("double", xd, yd, sum<double>, dot<double>,
+        [](float a, span<const double> x, span<double> y) {
+            axpy<double>(a, x, y);
+        });
+    run("float", xf, yf, sum<float>, dot<float>, axpy<float>);
+    run("bfloat16", xb, yb, half_float::sum<bfloat16>,
+        half_float::dot<bfloat16>, half_float::axpy<bfloat16>);
+    run("float16", xh, yh, half_float::sum<float16>, half_float::dot<float16>,
+        half_float::axpy<float16>);
+
+    println("\nbulk conversion:");
+    auto t = bench::time_best(reps, [&] {
+        half_float::from_float<float16>(xf, xh);
+        bench::clobber_memory();
+    });
+    report("float -> float16", t, sizeof(float) + sizeof(float16), 1);
+    t = bench::time_best(reps, [&] {
+        half_float::to_float<float16>(xh, xf);
+        bench::clobber_memory();
+    });
+    report("float16 -> float", t, sizeof(float) + sizeof(float16), 1);
+}
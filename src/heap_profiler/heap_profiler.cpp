@@ -0,0 +1,511 @@
+#include "heap_profiler/heap_profiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <functional>
+#include <new>
+#include <print>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+
+namespace heap_profiler {
+
+namespace {
+
+constexpr std::size_t max_sites = 4096;        // power of two
+constexpr std::size_t overflow_site = max_sites; // once the table is full
+constexpr std::size_t max_probes = 32;
+// Live bytes a thread accumulates before adding them to the global count
+constexpr std::int64_t flush_bytes = 64 << 10;
+
+constexpr std::uint64_t canary = 0xFDFD'FDFD'FDFD'FDFD;
+
+// In front of every block; `offset` leads back to the `malloc`ed address
+struct Header {
+    std::uint64_t size;
+    std::uint32_t site;
+    std::uint32_t offset;
+};
+static_assert(sizeof(Header) == alignof(std::max_align_t));
+
+struct Counters {
+    std::atomic<std::uint64_t> allocations{0};
+    std::atomic<std::uint64_t> frees{0};
+    std::atomic<std::uint64_t> bytes_allocated{0};
+    std::atomic<std::uint64_t> bytes_freed{0};
+    std::atomic<std::uint64_t> overruns{0};
+};
+
+// Counters of one thread at a time, so updates need no locked instruction;
+// reports sum every table. Tables of exited threads are reused (their
+// counts stay in the sums). Live bytes go to the global count in batches of
+// `flush_bytes`, so the peak is exact to within that per thread.
+struct ThreadTable {
+    std::array<Counters, max_sites + 1> sites{};
+    std::array<std::atomic<std::uint64_t>, num_size_classes> histogram{};
+    std::atomic<std::int64_t> pending_live{0};
+    std::atomic<bool> in_use{false};
+    ThreadTable *next = nullptr;
+};
+
+// Zero-initialized before any dynamic initialization, so `operator new` can
+// run from other translation units' static constructors. The first thread
+// to allocate (normally the main thread) takes `first_table`.
+constinit std::array<std::atomic<std::uintptr_t>, max_sites> site_addresses{};
+constinit ThreadTable first_table{};
+constinit std::atomic<ThreadTable *> tables{&first_table};
+constinit thread_local ThreadTable *this_thread_table = nullptr;
+constinit std::atomic<std::int64_t> live{0};
+constinit std::atomic<std::int64_t> peak{0};
+
+// Owner-only add: other threads only load, so no read-modify-write is needed
+void bump(std::atomic<std::uint64_t> &counter, std::uint64_t n) {
+    counter.store(counter.load(std::memory_order_relaxed) + n,
+                  std::memory_order_relaxed);
+}
+
+// Adds `bytes` (negative on free) to this thread's pending live bytes, and
+// those to the global count once they pass `flush_bytes` either way
+void add_live(ThreadTable &table, std::int64_t bytes) {
+    auto pending = table.pending_live.load(std::memory_order_relaxed) + bytes;
+    if (pending < flush_bytes && pending > -flush_bytes) [[likely]] {
+        table.pending_live.store(pending, std::memory_order_relaxed);
+        return;
+    }
+    table.pending_live.store(0, std::memory_order_relaxed);
+    auto now = live.fetch_add(pending, std::memory_order_relaxed) + pending;
+    auto high = peak.load(std::memory_order_relaxed);
+    while (now > high && !peak.compare_exchange_weak(
+                             high, now, std::memory_order_relaxed)) {
+    }
+}
+
+auto claim_table() -> ThreadTable * {
+    for (auto *t = tables.load(std::memory_order_acquire); t != nullptr;
+         t = t->next) {
+        bool in_use = false;
+        if (t->in_use.compare_exchange_strong(in_use, true,
+                                              std::memory_order_acquire)) {
+            return t;
+        }
+    }
+    // `malloc`, not `new`: this runs inside `operator new`
+    void *memory = std::malloc(sizeof(ThreadTable));
+    if (memory == nullptr) {
+        return &first_table; // shared: counts may be lost, never corrupted
+    }
+    auto *t = ::new (memory) ThreadTable{};
+    t->in_use.store(true, std::memory_order_relaxed);
+    t->next = tables.load(std::memory_order_relaxed);
+    while (!tables.compare_exchange_weak(t->next, t, std::memory_order_release,
+                                         std::memory_order_relaxed)) {
+    }
+    return t;
+}
+
+struct TableRelease {
+    TableRelease() = default;
+    TableRelease(const TableRelease &) = delete;
+    auto operator=(const TableRelease &) -> TableRelease & = delete;
+    ~TableRelease() {
+        this_thread_table->in_use.store(false, std::memory_order_release);
+        this_thread_table = nullptr;
+    }
+};
+
+auto thread_table() -> ThreadTable & {
+    if (this_thread_table == nullptr) [[unlikely]] {
+        this_thread_table = claim_table();
+        // hands the table back at thread exit; allocations after that (from
+        // later thread_local destructors) claim one for good
+        thread_local TableRelease release;
+    }
+    return *this_thread_table;
+}
+
+auto size_class(std::size_t size) -> std::size_t {
+    return std::min<std::size_t>(std::bit_width(size), num_size_classes - 1);
+}
+
+// Slot of `address` in the open-addressed table, claimed on first use
+auto find_site(std::uintptr_t address) -> std::size_t {
+    auto hash = static_cast<std::size_t>(
+        (address * 0x9E37'79B9'7F4A'7C15) >>
+        (64 - std::countr_zero(max_sites)));
+    for (std::size_t probe = 0; probe < max_probes; probe++) {
+        auto i = (hash + probe) & (max_sites - 1);
+        auto &slot = site_addresses[i];
+        auto key = slot.load(std::memory_order_relaxed);
+        if (key == address) {
+            return i;
+        }
+        if (key == 0) {
+            if (slot.compare_exchange_strong(key, address,
+                                             std::memory_order_relaxed) ||
+                key == address) {
+                return i;
+            }
+        }
+    }
+    return overflow_site;
+}
+
+auto allocate(std::size_t size, std::size_t alignment,
+              std::uintptr_t caller) noexcept -> void * {
+    auto offset = std::max(sizeof(Header), alignment);
+    if (size > SIZE_MAX - offset - sizeof(canary)) {
+        return nullptr;
+    }
+    auto total = offset + size + sizeof(canary);
+    // `aligned_alloc` takes a multiple of the alignment: round up, if it fits
+    if (total > SIZE_MAX - (alignment - 1)) {
+        return nullptr;
+    }
+    void *block = alignment <= alignof(std::max_align_t)
+                      ? std::malloc(total)
+                      : std::aligned_alloc(alignment, (total + alignment - 1) &
+                                                          ~(alignment - 1));
+    if (block == nullptr) {
+        return nullptr;
+    }
+    auto *user = static_cast<std::byte *>(block) + offset;
+    auto site = find_site(caller);
+    Header header{size, static_cast<std::uint32_t>(site),
+                  static_cast<std::uint32_t>(offset)};
+    std::memcpy(user - sizeof(Header), &header, sizeof(Header));
+    std::memcpy(user + size, &canary, sizeof(canary));
+
+    auto &table = thread_table();
+    auto &counters = table.sites[site];
+    bump(counters.allocations, 1);
+    bump(counters.bytes_allocated, size);
+    bump(table.histogram[size_class(size)], 1);
+    add_live(table, static_cast<std::int64_t>(size));
+    return user;
+}
+
+void deallocate(void *ptr) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+    auto *user = static_cast<std::byte *>(ptr);
+    Header header{};
+    std::memcpy(&header, user - sizeof(Header), sizeof(Header));
+    std::uint64_t tail = 0;
+    std::memcpy(&tail, user + header.size, sizeof(tail));
+
+    auto &table = thread_table();
+    auto &counters = table.sites[header.site];
+    if (tail != canary) {
+        bump(counters.overruns, 1);
+    }
+    bump(counters.frees, 1);
+    bump(counters.bytes_freed, header.size);
+    add_live(table, -static_cast<std::int64_t>(header.size));
+    std::free(user - header.offset);
+}
+
+// `operator new` semantics: retry through the new-handler, then throw
+auto allocate_or_throw(std::size_t size, std::size_t alignment,
+                       std::uintptr_t caller) -> void * {
+    for (;;) {
+        if (auto *ptr = allocate(size, alignment, caller)) {
+            return ptr;
+        }
+        auto *handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc{};
+        }
+        handler();
+    }
+}
+
+auto allocate_or_null(std::size_t size, std::size_t alignment,
+                      std::uintptr_t caller) noexcept -> void * {
+    try {
+        return allocate_or_throw(size, alignment, caller);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+// `std::allocator` through `malloc`, so reports don't count themselves
+template <typename T> struct Untracked {
+    using value_type = T;
+    Untracked() = default;
+    template <typename U> Untracked(const Untracked<U> & /*other*/) {}
+    auto allocate(std::size_t n) -> T * {
+        if (auto *p = static_cast<T *>(std::malloc(n * sizeof(T)))) {
+            return p;
+        }
+        throw std::bad_alloc{};
+    }
+    void deallocate(T *p, std::size_t /*n*/) { std::free(p); }
+    auto operator==(const Untracked & /*other*/) const -> bool {
+        return true;
+    }
+};
+
+using SiteList = std::vector<Site, Untracked<Site>>;
+
+// Every site with allocations, summed over the thread tables
+auto collect_sites() -> SiteList {
+    SiteList list(max_sites + 1);
+    for (auto *t = tables.load(std::memory_order_acquire); t != nullptr;
+         t = t->next) {
+        for (std::size_t i = 0; i <= max_sites; i++) {
+            const auto &c = t->sites[i];
+            auto &s = list[i];
+            s.allocations += c.allocations.load(std::memory_order_relaxed);
+            s.frees += c.frees.load(std::memory_order_relaxed);
+            s.bytes_allocated +=
+                c.bytes_allocated.load(std::memory_order_relaxed);
+            s.bytes_freed += c.bytes_freed.load(std::memory_order_relaxed);
+            s.overruns += c.overruns.load(std::memory_order_relaxed);
+        }
+    }
+    for (std::size_t i = 0; i < max_sites; i++) {
+        // NOLINTNEXTLINE(performance-no-int-to-ptr)
+        list[i].address = reinterpret_cast<const void *>(
+            site_addresses[i].load(std::memory_order_relaxed));
+    }
+    std::erase_if(list, [](const Site &s) { return s.allocations == 0; });
+    return list;
+}
+
+// "function+0x1f" if the symbol is exported, else "binary+0x1234"
+auto describe(const void *address) -> std::string {
+    if (address == nullptr) {
+        return "(other call sites)";
+    }
+    Dl_info info{};
+    if (dladdr(address, &info) == 0) {
+        return std::format("{}", address);
+    }
+    if (info.dli_sname == nullptr) {
+        std::string_view module = info.dli_fname;
+        module = module.substr(module.rfind('/') + 1);
+        return std::format("{}+{:#x}", module,
+                           static_cast<const std::byte *>(address) -
+                               static_cast<const std::byte *>(info.dli_fbase));
+    }
+    int status = 0;
+    char *demangled =
+        abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+    std::string name = status == 0 ? demangled : info.dli_sname;
+    std::free(demangled);
+    constexpr std::size_t max_name = 60;
+    if (name.size() > max_name) {
+        name = name.substr(0, max_name - 3) + "...";
+    }
+    return std::format("{}+{:#x}", name,
+                       static_cast<const std::byte *>(address) -
+                           static_cast<const std::byte *>(info.dli_saddr));
+}
+
+void print_sites(std::FILE *out, const SiteList &list, std::size_t top) {
+    std::println(out, "  {:>10} {:>10} {:>12} {:>12}  {}", "allocs", "frees",
+                 "bytes", "live bytes", "call site");
+    for (std::size_t i = 0; i < std::min(top, list.size()); i++) {
+        const auto &s = list[i];
+        std::println(out, "  {:>10} {:>10} {:>12} {:>12}  {}{}",
+                     s.allocations, s.frees, s.bytes_allocated,
+                     s.live_bytes(), describe(s.address),
+                     s.overruns == 0
+                         ? std::string{}
+                         : std::format(" ({} overruns)", s.overruns));
+    }
+    if (list.size() > top) {
+        std::println(out, "  ... {} more", list.size() - top);
+    }
+}
+
+// After every static destructor (those run from `exit` before the
+// `.fini_array` destructors)
+[[gnu::destructor]] void report_at_exit() {
+    std::fflush(stdout);
+    print_leaks(stderr);
+}
+
+} // namespace
+
+auto totals() -> Totals {
+    Totals t;
+    for (const auto &s : collect_sites()) {
+        t.allocations += s.allocations;
+        t.frees += s.frees;
+        t.bytes_allocated += s.bytes_allocated;
+        t.bytes_freed += s.bytes_freed;
+        t.overruns += s.overruns;
+    }
+    auto now = live.load(std::memory_order_relaxed);
+    for (auto *table = tables.load(std::memory_order_acquire);
+         table != nullptr; table = table->next) {
+        now += table->pending_live.load(std::memory_order_relaxed);
+    }
+    t.live_bytes = static_cast<std::uint64_t>(now);
+    t.peak_bytes = static_cast<std::uint64_t>(
+        std::max(now, peak.load(std::memory_order_relaxed)));
+    return t;
+}
+
+auto sites() -> std::vector<Site> {
+    auto list = collect_sites();
+    return {list.begin(), list.end()};
+}
+
+auto size_histogram() -> std::array<std::uint64_t, num_size_classes> {
+    std::array<std::uint64_t, num_size_classes> counts{};
+    for (auto *t = tables.load(std::memory_order_acquire); t != nullptr;
+         t = t->next) {
+        for (std::size_t k = 0; k < num_size_classes; k++) {
+            counts[k] += t->histogram[k].load(std::memory_order_relaxed);
+        }
+    }
+    return counts;
+}
+
+void reset_peak() {
+    peak.store(static_cast<std::int64_t>(totals().live_bytes),
+               std::memory_order_relaxed);
+}
+
+void print_report(std::FILE *out, std::size_t top) {
+    auto t = totals();
+    std::println(out, "heap: {} allocations, {} frees, {} bytes allocated",
+                 t.allocations, t.frees, t.bytes_allocated);
+    std::println(out, "heap: {} live bytes, {} peak bytes, {} overruns",
+                 t.live_bytes, t.peak_bytes, t.overruns);
+    std::println(out, "sizes (bytes):");
+    auto counts = size_histogram();
+    for (std::size_t k = 0; k < num_size_classes; k++) {
+        if (counts[k] == 0) {
+            continue;
+        }
+        auto low = k == 0 ? 0 : std::uint64_t{1} << (k - 1);
+        auto high = (std::uint64_t{1} << k) - 1;
+        if (k == num_size_classes - 1) {
+            std::println(out, "  {:>12}+      {:>10}", low, counts[k]);
+        } else {
+            std::println(out, "  {:>12}-{:<12} {:>10}", low, high, counts[k]);
+        }
+    }
+    auto list = collect_sites();
+    std::ranges::sort(list, std::greater{}, &Site::bytes_allocated);
+    std::println(out, "top call sites by bytes allocated:");
+    print_sites(out, list, top);
+}
+
+void print_leaks(std::FILE *out, std::size_t top) {
+    auto list = collect_sites();
+    std::erase_if(list, [](const Site &s) { return s.live_bytes() == 0; });
+    auto t = totals();
+    if (list.empty() && t.overruns == 0) {
+        std::println(out, "heap: no leaks ({} allocations, {} peak bytes)",
+                     t.allocations, t.peak_bytes);
+        return;
+    }
+    std::println(out, "heap: {} bytes leaked from {} call sites, {} overruns",
+                 t.live_bytes, list.size(), t.overruns);
+    std::ranges::sort(list, std::greater{}, &Site::live_bytes);
+    print_sites(out, list, top);
+}
+
+} // namespace heap_profiler
+
+// Replacements (global namespace); the caller's return address is the call
+// site, so these must not be inlined into anything
+#define CALLER reinterpret_cast<std::uintptr_t>(__builtin_return_address(0))
+
+namespace hp = heap_profiler;
+constexpr auto default_alignment = alignof(std::max_align_t);
+
+[[gnu::noinline]] auto operator new(std::size_t size) -> void * {
+    return hp::allocate_or_throw(size, default_alignment, CALLER);
+}
+[[gnu::noinline]] auto operator new[](std::size_t size) -> void * {
+    return hp::allocate_or_throw(size, default_alignment, CALLER);
+}
+[[gnu::noinline]] auto operator new(std::size_t size,
+                                    const std::nothrow_t & /*tag*/) noexcept
+    -> void * {
+    return hp::allocate_or_null(size, default_alignment, CALLER);
+}
+[[gnu::noinline]] auto operator new[](std::size_t size,
+                                      const std::nothrow_t & /*tag*/) noexcept
+    -> void * {
+    return hp::allocate_or_null(size, default_alignment, CALLER);
+}
+[[gnu::noinline]] auto operator new(std::size_t size, std::align_val_t align)
+    -> void * {
+    return hp::allocate_or_throw(size, static_cast<std::size_t>(align),
+                                 CALLER);
+}
+[[gnu::noinline]] auto operator new[](std::size_t size, std::align_val_t align)
+    -> void * {
+    return hp::allocate_or_throw(size, static_cast<std::size_t>(align),
+                                 CALLER);
+}
+[[gnu::noinline]] auto operator new(std::size_t size, std::align_val_t align,
+                                    const std::nothrow_t & /*tag*/) noexcept
+    -> void * {
+    return hp::allocate_or_null(size, static_cast<std::size_t>(align),
+                                CALLER);
+}
+[[gnu::noinline]] auto operator new[](std::size_t size, std::align_val_t align,
+                                      const std::nothrow_t & /*tag*/) noexcept
+    -> void * {
+    return hp::allocate_or_null(size, static_cast<std::size_t>(align),
+                                CALLER);
+}
+
+#undef CALLER
+
+void operator delete(void *ptr) noexcept { hp::deallocate(ptr); }
+void operator delete[](void *ptr) noexcept { hp::deallocate(ptr); }
+void operator delete(void *ptr, std::size_t /*size*/) noexcept {
+    hp::deallocate(ptr);
+}
+void operator delete[](void *ptr, std::size_t /*size*/) noexcept {
+    hp::deallocate(ptr);
+}
+void operator delete(void *ptr, std::align_val_t /*align*/) noexcept {
+    hp::deallocate(ptr);
+}
+void operator delete[](void *ptr, std::align_val_t /*align*/) noexcept {
+    hp::deallocate(ptr);
+}
+void operator delete(void *ptr, std::size_t /*size*/,
+                     std::align_val_t /*align*/) noexcept {
+    hp::deallocate(ptr);
+}
+void operator delete[](void *ptr, std::size_t /*size*/,
+                       std::align_val_t /*align*/) noexcept {
+    hp::deallocate(ptr);
+}
+void operator delete(void *ptr, const std::nothrow_t & /*tag*/) noexcept {
+    hp::deallocate(ptr);
+}
+void operator delete[](void *ptr, const std::nothrow_t & /*tag*/) noexcept {
+    hp::deallocate(ptr);
+}
+void operator delete(void *ptr, std::align_val_t /*align*/,
+                     const std::nothrow_t & /*tag*/) noexcept {
+    hp::deallocate(ptr);
+}
+void operator delete[](void *ptr, std::align_val_t /*align*/,
+                       const std::nothrow_t & /*tag*/) noexcept {
+    hp::deallocate(ptr);
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+// Heap profiler: replacement global `operator new`/`delete`
+//
+// basic_concepts_iv leaks `new int{10}` (`ml = nullptr`) and writes past a
+// `new int` across a whole page; without the commented-out sanitizers
+// nothing reports either. Linking `heap_profiler.cpp` (the `heap_profiler`
+// CMake object library) into an executable replaces every form of global
+// `operator new`/`delete` (plain, array, nothrow, aligned, sized) with
+// versions that record:
+//   - per call site (the return address of `operator new`, so the function
+//     that allocated, or the `std::allocator` inlined into it): allocations,
+//     frees, bytes allocated and freed - live bytes are the difference
+//   - a histogram of allocation sizes by power of two
+//   - live and peak bytes over the whole program (the peak to within
+//     64 KiB per thread: threads add to the global count in batches)
+//   - buffer overruns: 8 canary bytes follow every block and are checked
+//     on `delete` (writes further out, like basic_concepts_iv's, can still
+//     land anywhere)
+// and print the leaked call sites to stderr at exit, after static
+// destructors have run.
+//
+// Each block carries a 16-byte header (its size and site). The hot path is
+// a hash lookup of the call site and plain adds to counters owned by the
+// calling thread (no locked instructions), so it's cheap enough to leave
+// linked into release benchmarks.
+//
+// Names of call sites come from `dladdr`, which needs the executable's
+// symbols exported (`-rdynamic`, CMake `ENABLE_EXPORTS`); otherwise
+// `binary+offset` is printed, for `addr2line`. `malloc`/`free` are not
+// tracked.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace heap_profiler {
+
+// Size class k counts sizes in [2^(k-1), 2^k); class 0 is size 0 and the
+// last class everything from 2^(num_size_classes - 2) up
+inline constexpr std::size_t num_size_classes = 40;
+
+struct Totals {
+    std::uint64_t allocations = 0;
+    std::uint64_t frees = 0;
+    std::uint64_t bytes_allocated = 0;
+    std::uint64_t bytes_freed = 0;
+    std::uint64_t live_bytes = 0;
+    std::uint64_t peak_bytes = 0;
+    std::uint64_t overruns = 0;
+};
+
+struct Site {
+    const void *address = nullptr; // nullptr: sites beyond the table
+    std::uint64_t allocations = 0;
+    std::uint64_t frees = 0;
+    std::uint64_t bytes_allocated = 0;
+    std::uint64_t bytes_freed = 0;
+    std::uint64_t overruns = 0;
+
+    [[nodiscard]] auto live_bytes() const -> std::uint64_t {
+        return bytes_allocated - bytes_freed;
+    }
+};
+
+// Since program start
+auto totals() -> Totals;
+// Every call site seen so far (the returned vector is itself an allocation)
+auto sites() -> std::vector<Site>;
+auto size_histogram() -> std::array<std::uint64_t, num_size_classes>;
+
+// Restart peak tracking from the current live bytes (ex. before a phase)
+void reset_peak();
+
+// Totals, the size histogram and the `top` call sites by bytes allocated
+void print_report(std::FILE *out, std::size_t top = 10);
+// Call sites with live bytes (what is printed at exit)
+void print_leaks(std::FILE *out, std::size_t top = 20);
+
+} // namespace heap_profiler
@@ -0,0 +1,116 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <print>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench/bench.hpp"
+#ifdef HEAP_PROFILER_LINKED
+#include "heap_profiler/heap_profiler.hpp"
+#endif
+
+using namespace std;
+
+#define PRINT_VAR(var) std::println("{} = {}", #var, var);
+
+// Built twice: `heap_profiler_bench` links the profiler (which defines
+// HEAP_PROFILER_LINKED), `heap_profiler_baseline_bench` doesn't, so the two
+// runs show the overhead
+
+constexpr size_t num_pairs = 1'000'000;
+constexpr size_t num_strings = 200'000;
+constexpr size_t num_inserts = 200'000;
+constexpr int reps = 5;
+
+struct Node {
+    Node *next;
+    uint64_t payload[3];
+};
+
+// basic_concepts_iv: a leak and an overrun, in functions of their own so
+// the report names them
+[[gnu::noinline]] void leak() {
+    int *ml = new int{10};
+    bench::do_not_optimize(ml);
+    ml = nullptr; // the memory can no longer be deallocated
+    bench::do_not_optimize(ml);
+}
+
+[[gnu::noinline]] void overrun(size_t count) {
+    int *ip = new int[count];
+    bench::do_not_optimize(ip);
+    for (size_t i = 0; i <= count; i++) {
+        ip[i] = 1; // one past the end: lands in the profiler's canary
+    }
+    bench::do_not_optimize(ip);
+    delete[] ip;
+}
+
+auto main() -> int {
+    println("Heap profiler - replaced operator new/delete");
+
+#ifdef HEAP_PROFILER_LINKED
+    leak();
+    overrun(4);
+    auto totals = heap_profiler::totals();
+    PRINT_VAR(totals.live_bytes)
+    PRINT_VAR(totals.overruns)
+#else
+    println("(baseline build: default operator new)");
+#endif
+
+    println("\nallocation-heavy workloads:");
+    auto t = bench::time_best(reps, [] {
+        for (size_t i = 0; i < num_pairs; i++) {
+            auto *node = new Node{};
+            bench::do_not_optimize(node);
+            delete node;
+        }
+    });
+    bench::report("new/delete 32-byte node", t, num_pairs, "allocations");
+
+    vector<unique_ptr<Node>> nodes(num_pairs);
+    t = bench::time_best(reps, [&] {
+        for (auto &node : nodes) {
+            node = make_unique<Node>();
+        }
+        for (auto &node : nodes) {
+            node.reset();
+        }
+    });
+    bench::report("1M live nodes, then free", t, num_pairs, "allocations");
+
+    t = bench::time_best(reps, [] {
+        vector<string> texts;
+        for (size_t i = 0; i < num_strings; i++) {
+            texts.push_back("a string too long for SSO #" + to_string(i));
+        }
+        bench::do_not_optimize(texts.data());
+    });
+    bench::report("vector<string> push_back", t, num_strings, "strings");
+
+    mt19937 rng{23};
+    vector<uint32_t> keys(num_inserts);
+    for (auto &key : keys) {
+        key = static_cast<uint32_t>(rng());
+    }
+    t = bench::time_best(reps, [&] {
+        map<uint32_t, uint64_t> index;
+        for (auto key : keys) {
+            index[key] += key;
+        }
+        bench::do_not_optimize(index.size());
+    });
+    bench::report("map inserts", t, num_inserts, "inserts");
+
+#ifdef HEAP_PROFILER_LINKED
+    println("");
+    fflush(stdout);
+    heap_profiler::print_report(stdout, 8);
+    // the leak from `leak()` is reported on stderr at exit
+#endif
+}
@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <print>
+#include <random>
+#include <string_view>
+
+#include "bench/bench.hpp"
+#include "matrix/matrix.hpp"
+
+using namespace std;
+
+#define PRINT_VAR(var) std::println("{} = {}", #var, var);
+
+constexpr array<size_t, 4> sizes = {64, 256, 512, 1024};
+// the naive product takes seconds past this
+constexpr size_t max_naive_size = 512;
+constexpr int reps = 3;
+
+using matrix::Layout;
+using matrix::Matrix;
+
+template <Layout L> auto random_matrix(size_t n, unsigned seed) {
+    mt19937 rng{seed};
+    uniform_real_distribution<float> dist{-1, 1};
+    Matrix<float, L> m(n, n);
+    for (auto &v : m.values()) {
+        v = dist(rng);
+    }
+    return m;
+}
+
+// "<name>  <rate> GFLOP/s  (<ms> ms)", like `bench::report`
+void report_gflops(string_view name, double seconds, size_t n) {
+    auto flops = 2.0 * static_cast<double>(n * n * n);
+    println("  {:<36} {:>10.2f} GFLOP/s  ({:.2f} ms)", name,
+            flops / seconds / 1e9, seconds * 1e3);
+}
+
+template <Layout L>
+auto max_difference(const Matrix<float, L> &a, const Matrix<float, L> &b)
+    -> float {
+    float diff = 0;
+    for (size_t i = 0; i < a.values().size(); i++) {
+        diff = max(diff, abs(a.values()[i] - b.values()[i]));
+    }
+    return diff;
+}
+
+void bench_multiply(size_t n) {
+    println("\n{} x {} float matrices:", n, n);
+    auto a = random_matrix<Layout::row_major>(n, 1);
+    auto b = random_matrix<Layout::row_major>(n, 2);
+    auto a_col = matrix::to_layout<Layout::col_major>(a);
+    auto b_col = matrix::to_layout<Layout::col_major>(b);
+
+    Matrix<float> c;
+    auto t = bench::time_best(reps, [&] { c = matrix::multiply(a, b); });
+    report_gflops("multiply (row-major)", t, n);
+    Matrix<float, Layout::col_major> c_col;
+    t = bench::time_best(reps,
+                         [&] { c_col = matrix::multiply(a_col, b_col); });
+    report_gflops("multiply (column-major)", t, n);
+    Matrix<float> c_mixed;
+    t = bench::time_best(reps, [&] { c_mixed = matrix::multiply(a, b_col); });
+    report_gflops("multiply (row- x column-major)", t, n);
+
+    if (n <= max_naive_size) {
+        Matrix<float> naive;
+        t = bench::time_best(1, [&] { naive = matrix::multiply_naive(a, b); });
+        report_gflops("naive triple loop (row-major)", t, n);
+        Matrix<float, Layout::col_major> naive_col;
+        t = bench::time_best(
+            1, [&] { naive_col = matrix::multiply_naive(a_col, b_col); });
+        report_gflops("naive triple loop (column-major)", t, n);
+        println("  max difference from naive: {}",
+                max({max_difference(c, naive),
+                     max_difference(c_col, naive_col),
+                     max_difference(c_mixed, naive)}));
+    }
+
+    auto elements = static_cast<double>(n * n);
+    Matrix<float> at;
+    t = bench::time_best(reps, [&] { at = matrix::transpose(a); });
+    bench::report("transpose (tiled)", t, elements, "elements");
+    t = bench::time_best(reps, [&] {
+        at = Matrix<float>(n, n);
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < n; j++) {
+                at(j, i) = a(i, j);
+            }
+        }
+    });
+    bench::report("transpose (naive)", t, elements, "elements");
+
+    Matrix<float> sum = a;
+    t = bench::time_best(reps, [&] { sum += b; });
+    bench::report("sum += b (SIMD)", t, elements, "elements");
+    t = bench::time_best(reps, [&] {
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < n; j++) {
+                sum(i, j) += b(i, j);
+            }
+        }
+    });
+    bench::report("sum(i, j) += b(i, j) (element loop)", t, elements,
+                  "elements");
+    bench::do_not_optimize(sum.values()[0]);
+}
+
+auto main() -> int {
+    println("Matrix - cache-blocked dense matrices");
+
+    // basic_concepts_iii: `std::array<std::array<int, 4>, 2> matrix`, with
+    // a runtime shape and a choice of layout
+    Matrix<float> rows(2, 4);
+    Matrix<float, Layout::col_major> cols(2, 4);
+    for (size_t r = 0; r < 2; r++) {
+        for (size_t c = 0; c < 4; c++) {
+            rows(r, c) = static_cast<float>((r * 4) + c);
+            cols(r, c) = rows(r, c);
+        }
+    }
+    println("row-major storage:    {}", rows.values());
+    println("column-major storage: {}", cols.values());
+    auto product = matrix::multiply(rows, matrix::transpose(rows));
+    println("rows * rows^T = {}", product.values());
+    auto sizeof_matrix = sizeof(rows);
+    PRINT_VAR(sizeof_matrix)
+
+    for (auto n : sizes) {
+        bench_multiply(n);
+    }
+}
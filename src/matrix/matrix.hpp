@@ -0,0 +1,369 @@
+#pragma once
+
+// Dense matrices over contiguous storage
+//
+// `std::array<std::array<int, 4>, 2>` (basic_concepts_iii) is a fine
+// `int[2][4]`, but its shape is fixed at compile time and its layout is
+// always rows of rows. `Matrix<T, Layout>` keeps one `std::vector<T>` with
+// a runtime shape, in row-major (`m(r, c)` at `r * cols + c`) or
+// column-major (`r + c * rows`) order, and
+//   - elementwise ops (`+`, `-`, scalar `*`, `hadamard`) run over the
+//     storage in `native_simd` chunks; both operands share a layout, so the
+//     order doesn't matter
+//   - `transpose` / `to_layout` copy in square tiles, so both the rows read
+//     and the columns written stay in L1 instead of striding over the whole
+//     matrix
+//   - `multiply` is blocked three ways: a `kc`-deep slab of B rows, `nc`
+//     columns of it at a time (sized to stay in L2), and a register tile of
+//     `mr` rows x two SIMD vectors of C that is accumulated over the whole
+//     slab before being written back
+//
+// A column-major matrix is stored exactly like its transpose in row-major,
+// so `multiply` of two column-major matrices runs the row-major kernel on
+// C^T = B^T A^T; mixed layouts convert the second operand first (O(n^2) of
+// an O(n^3) product).
+//
+// Shape mismatches throw `std::invalid_argument`.
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <experimental/simd>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace matrix {
+
+namespace stdx = std::experimental;
+
+enum class Layout : std::uint8_t { row_major, col_major };
+
+template <std::floating_point T, Layout L = Layout::row_major> class Matrix {
+  public:
+    using value_type = T;
+    static constexpr Layout layout = L;
+
+    Matrix() = default;
+    Matrix(std::size_t rows, std::size_t cols, T value = 0)
+        : rows_{rows}, cols_{cols}, values_(rows * cols, value) {}
+
+    [[nodiscard]] auto rows() const -> std::size_t { return rows_; }
+    [[nodiscard]] auto cols() const -> std::size_t { return cols_; }
+
+    // Shape of the storage seen as a row-major array (swapped for
+    // column-major)
+    [[nodiscard]] auto storage_rows() const -> std::size_t {
+        return L == Layout::row_major ? rows_ : cols_;
+    }
+    [[nodiscard]] auto storage_cols() const -> std::size_t {
+        return L == Layout::row_major ? cols_ : rows_;
+    }
+
+    auto operator()(std::size_t r, std::size_t c) -> T & {
+        return values_[offset(r, c)];
+    }
+    auto operator()(std::size_t r, std::size_t c) const -> const T & {
+        return values_[offset(r, c)];
+    }
+
+    // Every element, in storage order
+    auto values() -> std::span<T> { return values_; }
+    [[nodiscard]] auto values() const -> std::span<const T> {
+        return values_;
+    }
+    auto data() -> T * { return values_.data(); }
+    [[nodiscard]] auto data() const -> const T * { return values_.data(); }
+
+    auto operator+=(const Matrix &other) -> Matrix &;
+    auto operator-=(const Matrix &other) -> Matrix &;
+    auto operator*=(T scale) -> Matrix &;
+
+    friend auto operator+(Matrix a, const Matrix &b) -> Matrix {
+        return a += b;
+    }
+    friend auto operator-(Matrix a, const Matrix &b) -> Matrix {
+        return a -= b;
+    }
+    friend auto operator*(Matrix a, T scale) -> Matrix { return a *= scale; }
+    friend auto operator*(T scale, Matrix a) -> Matrix { return a *= scale; }
+
+    auto operator==(const Matrix &) const -> bool = default;
+
+  private:
+    [[nodiscard]] auto offset(std::size_t r, std::size_t c) const
+        -> std::size_t {
+        return L == Layout::row_major ? (r * cols_) + c : r + (c * rows_);
+    }
+
+    std::size_t rows_ = 0;
+    std::size_t cols_ = 0;
+    std::vector<T> values_;
+};
+
+namespace detail {
+
+template <typename T> using simd_t = stdx::native_simd<T>;
+
+template <typename T, Layout L>
+void check_same_shape(const Matrix<T, L> &a, const Matrix<T, L> &b) {
+    if (a.rows() != b.rows() || a.cols() != b.cols()) {
+        throw std::invalid_argument{"matrix: shapes differ"};
+    }
+}
+
+// `out[i] = op(out[i], in[i])`, SIMD chunks then a scalar tail (`op` takes
+// both `simd_t<T>` and `T`)
+template <typename T, typename Op>
+void transform(std::span<T> out, std::span<const T> in, Op op) {
+    using V = simd_t<T>;
+    std::size_t i = 0;
+    for (; i + V::size() <= out.size(); i += V::size()) {
+        V x{out.data() + i, stdx::element_aligned};
+        V y{in.data() + i, stdx::element_aligned};
+        op(x, y).copy_to(out.data() + i, stdx::element_aligned);
+    }
+    for (; i < out.size(); i++) {
+        out[i] = op(out[i], in[i]);
+    }
+}
+
+template <typename T, typename Op> void transform(std::span<T> out, Op op) {
+    using V = simd_t<T>;
+    std::size_t i = 0;
+    for (; i + V::size() <= out.size(); i += V::size()) {
+        V x{out.data() + i, stdx::element_aligned};
+        op(x).copy_to(out.data() + i, stdx::element_aligned);
+    }
+    for (; i < out.size(); i++) {
+        out[i] = op(out[i]);
+    }
+}
+
+// Row-major `rows x cols` at `src` (row stride `src_ld`) into row-major
+// `cols x rows` at `dst` (row stride `dst_ld`), one square tile at a time
+inline constexpr std::size_t transpose_tile = 32;
+
+template <typename T>
+void transpose(const T *src, std::size_t src_ld, T *dst, std::size_t dst_ld,
+               std::size_t rows, std::size_t cols) {
+    for (std::size_t r0 = 0; r0 < rows; r0 += transpose_tile) {
+        auto r1 = std::min(r0 + transpose_tile, rows);
+        for (std::size_t c0 = 0; c0 < cols; c0 += transpose_tile) {
+            auto c1 = std::min(c0 + transpose_tile, cols);
+            for (std::size_t r = r0; r < r1; r++) {
+                for (std::size_t c = c0; c < c1; c++) {
+                    dst[(c * dst_ld) + r] = src[(r * src_ld) + c];
+                }
+            }
+        }
+    }
+}
+
+// Blocking of `gemm`: `kc` rows of B (and columns of A) per slab, `nc`
+// columns of the slab at a time (`kc * nc` values stay in L2), and C in
+// `mr` x `nr` register tiles (6 x 2 accumulators, plus 2 vectors of B and
+// a broadcast of A, fit the 16 vector registers of SSE/AVX2)
+inline constexpr std::size_t kc = 256;
+inline constexpr std::size_t nc = 256;
+inline constexpr std::size_t mr = 6;
+template <typename T>
+inline constexpr std::size_t nr = 2 * simd_t<T>::size();
+
+// `f(std::integral_constant<std::size_t, i>{})` for i in [0, N), expanded
+// at compile time: the register tile must not become a loop over an array
+// in memory (which gcc does at -O2)
+template <std::size_t N, typename F> void unroll(F &&f) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (f(std::integral_constant<std::size_t, I>{}), ...);
+    }(std::make_index_sequence<N>{});
+}
+
+// C[R x NV vectors] += A[R x depth] * B[depth x NV vectors], with the C
+// tile held in registers across the whole depth
+template <std::size_t R, std::size_t NV, typename T>
+void micro_kernel(const T *a, std::size_t lda, const T *b, std::size_t ldb,
+                  T *c, std::size_t ldc, std::size_t depth) {
+    using V = simd_t<T>;
+    constexpr std::size_t W = V::size();
+    std::array<std::array<V, NV>, R> acc;
+    unroll<R>([&](auto r) {
+        unroll<NV>([&](auto v) {
+            acc[r][v].copy_from(c + (r * ldc) + (v * W),
+                                stdx::element_aligned);
+        });
+    });
+    for (std::size_t p = 0; p < depth; p++) {
+        std::array<V, NV> bv;
+        unroll<NV>([&](auto v) {
+            bv[v].copy_from(b + (p * ldb) + (v * W), stdx::element_aligned);
+        });
+        unroll<R>([&](auto r) {
+            V av = a[(r * lda) + p];
+            unroll<NV>([&](auto v) {
+                // contracted to an FMA where the target has one (gcc's
+                // C++ default, -ffp-contract=fast); `stdx::fma` isn't
+                // inlined by libstdc++ at -O2
+                acc[r][v] += av * bv[v];
+            });
+        });
+    }
+    unroll<R>([&](auto r) {
+        unroll<NV>([&](auto v) {
+            acc[r][v].copy_to(c + (r * ldc) + (v * W), stdx::element_aligned);
+        });
+    });
+}
+
+// R rows of C, columns [j0, j1): full register tiles, then one vector, then
+// scalar columns
+template <std::size_t R, typename T>
+void row_panel(const T *a, std::size_t lda, const T *b, std::size_t ldb,
+               T *c, std::size_t ldc, std::size_t depth, std::size_t j0,
+               std::size_t j1) {
+    constexpr std::size_t W = simd_t<T>::size();
+    auto j = j0;
+    for (; j + nr<T> <= j1; j += nr<T>) {
+        micro_kernel<R, 2>(a, lda, b + j, ldb, c + j, ldc, depth);
+    }
+    for (; j + W <= j1; j += W) {
+        micro_kernel<R, 1>(a, lda, b + j, ldb, c + j, ldc, depth);
+    }
+    for (; j < j1; j++) {
+        for (std::size_t r = 0; r < R; r++) {
+            T sum = c[(r * ldc) + j];
+            for (std::size_t p = 0; p < depth; p++) {
+                sum += a[(r * lda) + p] * b[(p * ldb) + j];
+            }
+            c[(r * ldc) + j] = sum;
+        }
+    }
+}
+
+// Row-major C[m x n] += A[m x k] * B[k x n]
+template <typename T>
+void gemm(const T *a, std::size_t lda, const T *b, std::size_t ldb, T *c,
+          std::size_t ldc, std::size_t m, std::size_t n, std::size_t k) {
+    for (std::size_t p0 = 0; p0 < k; p0 += kc) {
+        auto depth = std::min(kc, k - p0);
+        for (std::size_t j0 = 0; j0 < n; j0 += nc) {
+            auto j1 = std::min(j0 + nc, n);
+            std::size_t i = 0;
+            for (; i + mr <= m; i += mr) {
+                row_panel<mr>(a + (i * lda) + p0, lda, b + (p0 * ldb), ldb,
+                              c + (i * ldc), ldc, depth, j0, j1);
+            }
+            for (; i < m; i++) {
+                row_panel<1>(a + (i * lda) + p0, lda, b + (p0 * ldb), ldb,
+                             c + (i * ldc), ldc, depth, j0, j1);
+            }
+        }
+    }
+}
+
+} // namespace detail
+
+template <std::floating_point T, Layout L>
+auto Matrix<T, L>::operator+=(const Matrix &other) -> Matrix & {
+    detail::check_same_shape(*this, other);
+    detail::transform(values(), other.values(),
+                      [](auto x, auto y) { return x + y; });
+    return *this;
+}
+
+template <std::floating_point T, Layout L>
+auto Matrix<T, L>::operator-=(const Matrix &other) -> Matrix & {
+    detail::check_same_shape(*this, other);
+    detail::transform(values(), other.values(),
+                      [](auto x, auto y) { return x - y; });
+    return *this;
+}
+
+template <std::floating_point T, Layout L>
+auto Matrix<T, L>::operator*=(T scale) -> Matrix & {
+    detail::transform(values(), [scale](auto x) { return x * scale; });
+    return *this;
+}
+
+// Elementwise product
+template <std::floating_point T, Layout L>
+auto hadamard(Matrix<T, L> a, const Matrix<T, L> &b) -> Matrix<T, L> {
+    detail::check_same_shape(a, b);
+    detail::transform(a.values(), b.values(),
+                      [](auto x, auto y) { return x * y; });
+    return a;
+}
+
+// Same values, stored in the other order (or copied, for the same layout)
+template <Layout To, std::floating_point T, Layout L>
+auto to_layout(const Matrix<T, L> &m) -> Matrix<T, To> {
+    Matrix<T, To> out(m.rows(), m.cols());
+    if constexpr (To == L) {
+        std::ranges::copy(m.values(), out.values().begin());
+    } else {
+        detail::transpose(m.data(), m.storage_cols(), out.data(),
+                          out.storage_cols(), m.storage_rows(),
+                          m.storage_cols());
+    }
+    return out;
+}
+
+template <std::floating_point T, Layout L>
+auto transpose(const Matrix<T, L> &m) -> Matrix<T, L> {
+    // the storage of m^T in layout L is the storage of m in the other
+    // layout
+    Matrix<T, L> out(m.cols(), m.rows());
+    detail::transpose(m.data(), m.storage_cols(), out.data(),
+                      out.storage_cols(), m.storage_rows(), m.storage_cols());
+    return out;
+}
+
+// A * B, in the layout of A
+template <std::floating_point T, Layout LA, Layout LB>
+auto multiply(const Matrix<T, LA> &a, const Matrix<T, LB> &b)
+    -> Matrix<T, LA> {
+    if constexpr (LA != LB) {
+        return multiply(a, to_layout<LA>(b));
+    } else {
+        if (a.cols() != b.rows()) {
+            throw std::invalid_argument{"matrix: inner dimensions differ"};
+        }
+        Matrix<T, LA> c(a.rows(), b.cols());
+        if constexpr (LA == Layout::row_major) {
+            detail::gemm(a.data(), a.cols(), b.data(), b.cols(), c.data(),
+                         c.cols(), a.rows(), b.cols(), a.cols());
+        } else {
+            // column-major storage is the row-major transpose: C^T = B^T A^T
+            detail::gemm(b.data(), b.rows(), a.data(), a.rows(), c.data(),
+                         c.rows(), b.cols(), a.rows(), a.cols());
+        }
+        return c;
+    }
+}
+
+// Textbook triple loop (dot product of a row of A and a column of B per
+// element), for reference
+template <std::floating_point T, Layout LA, Layout LB>
+auto multiply_naive(const Matrix<T, LA> &a, const Matrix<T, LB> &b)
+    -> Matrix<T, LA> {
+    if (a.cols() != b.rows()) {
+        throw std::invalid_argument{"matrix: inner dimensions differ"};
+    }
+    Matrix<T, LA> c(a.rows(), b.cols());
+    for (std::size_t i = 0; i < a.rows(); i++) {
+        for (std::size_t j = 0; j < b.cols(); j++) {
+            T sum = 0;
+            for (std::size_t p = 0; p < a.cols(); p++) {
+                sum += a(i, p) * b(p, j);
+            }
+            c(i, j) = sum;
+        }
+    }
+    return c;
+}
+
+} // namespace matrix
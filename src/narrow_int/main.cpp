@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <print>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "narrow_int/narrow_int.hpp"
+
+using namespace std;
+
+#define PRINT_VAR(var) std::println("{} = {}", #var, var);
+
+constexpr size_t num_values = 16'000'000;
+constexpr int reps = 5;
+
+using narrow_int::Overflow;
+
+template <typename T> //
+auto make_column(unsigned seed) -> vector<T> {
+    mt19937 rng{seed};
+    uniform_int_distribution<int> dist{numeric_limits<T>::min(),
+                                       numeric_limits<T>::max()};
+    vector<T> column(num_values);
+    for (auto &v : column) {
+        v = static_cast<T>(dist(rng));
+    }
+    return column;
+}
+
+template <typename T> //
+auto saturate(int value) -> T {
+    return static_cast<T>(
+        std::clamp(value, int{numeric_limits<T>::min()},
+                   int{numeric_limits<T>::max()}));
+}
+
+// `plain` is the promoting loop body; `kernel` the narrow_int call
+template <typename T, typename Plain, typename Kernel>
+void run(const char *label, const vector<T> &a, const vector<T> &b,
+         Plain plain, Kernel kernel) {
+    vector<T> expected(num_values);
+    vector<T> out(num_values);
+    println("\n{}:", label);
+
+    auto t = bench::time_best(reps, [&] {
+        for (size_t i = 0; i < num_values; i++) {
+            expected[i] = plain(a[i], b[i]);
+        }
+        bench::do_not_optimize(expected.data());
+    });
+    bench::report("plain loop (promotes to int)", t, num_values, "values");
+
+    t = bench::time_best(reps, [&] {
+        kernel(span<const T>{a}, span<const T>{b}, span<T>{out});
+        bench::do_not_optimize(out.data());
+    });
+    bench::report("narrow_int kernel", t, num_values, "values");
+
+    if (out != expected) {
+        println("  !! results differ");
+    }
+}
+
+auto main() -> int {
+    println("Narrow Int - int8/int16 SIMD arithmetic without promotion");
+
+    println("\nthe promotion from basic_concepts_i:");
+    short h = 6;
+    PRINT_VAR(sizeof(h + h))
+    PRINT_VAR(sizeof(h))
+
+    println("\n{} values per column", num_values);
+    auto a16 = make_column<int16_t>(1);
+    auto b16 = make_column<int16_t>(2);
+    auto a8 = make_column<int8_t>(3);
+    auto b8 = make_column<int8_t>(4);
+
+    run(
+        "int16 add (wrap)", a16, b16,
+        [](int16_t x, int16_t y) { return static_cast<int16_t>(x + y); },
+        narrow_int::add<Overflow::wrap, int16_t>);
+    run(
+        "int16 add (saturate)", a16, b16,
+        [](int16_t x, int16_t y) { return saturate<int16_t>(x + y); },
+        narrow_int::add<Overflow::saturate, int16_t>);
+    run(
+        "int16 sub (saturate)", a16, b16,
+        [](int16_t x, int16_t y) { return saturate<int16_t>(x - y); },
+        narrow_int::sub<Overflow::saturate, int16_t>);
+    run(
+        "int16 mul (saturate)", a16, b16,
+        [](int16_t x, int16_t y) { return saturate<int16_t>(x * y); },
+        narrow_int::mul<Overflow::saturate, int16_t>);
+    run(
+        "int16 max", a16, b16, [](int16_t x, int16_t y) { return max(x, y); },
+        narrow_int::max<int16_t>);
+    run(
+        "int16 abs (saturate)", a16, b16,
+        [](int16_t x, int16_t) { return saturate<int16_t>(x < 0 ? -x : x); },
+        [](span<const int16_t> a, span<const int16_t>, span<int16_t> out) {
+            narrow_int::abs<Overflow::saturate>(a, out);
+        });
+    run(
+        "int8 add (saturate)", a8, b8,
+        [](int8_t x, int8_t y) { return saturate<int8_t>(x + y); },
+        narrow_int::add<Overflow::saturate, int8_t>);
+    run(
+        "int8 mul (wrap)", a8, b8,
+        [](int8_t x, int8_t y) { return static_cast<int8_t>(x * y); },
+        narrow_int::mul<Overflow::wrap, int8_t>);
+}
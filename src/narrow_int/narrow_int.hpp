@@ -0,0 +1,195 @@
+#pragma once
+
+// Element-wise arithmetic on int8/int16 columns without integer promotion
+//
+// `h + h` on two `short`s is computed as `int` (integer promotion). Written as
+// a plain loop, that can make the compiler widen every lane to 32 bits, which
+// halves the lanes per register and doubles the register traffic. These
+// kernels keep `T`-wide lanes from load to store (`std::experimental::simd`
+// of `T`), and make overflow behaviour explicit:
+//   - `Overflow::wrap`     - modular arithmetic (what `static_cast<T>(a + b)`
+//                            gives since C++20)
+//   - `Overflow::saturate` - clamp to [numeric_limits<T>::min(), max()]
+//                            (like C++26 `std::add_sat` and friends)
+//
+// Saturation is detected from the wrapped result's sign bits rather than by
+// widening; only `mul` has to widen internally, since a 16x16 product needs
+// 32 bits before it can be clamped.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <experimental/simd>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+namespace narrow_int {
+
+namespace stdx = std::experimental;
+
+enum class Overflow : std::uint8_t { wrap, saturate };
+
+template <typename T>
+concept narrow_integer =
+    std::is_same_v<T, std::int8_t> || std::is_same_v<T, std::uint8_t> ||
+    std::is_same_v<T, std::int16_t> || std::is_same_v<T, std::uint16_t>;
+
+namespace detail {
+
+template <typename T> using simd_t = stdx::native_simd<T>;
+
+template <typename T> constexpr T min_v = std::numeric_limits<T>::min();
+template <typename T> constexpr T max_v = std::numeric_limits<T>::max();
+
+// Scalar reference semantics (used for the tail)
+// - computed in 64 bits: `uint16_t * uint16_t` promotes to `int` and can
+//   overflow it
+template <Overflow mode, typename T>
+constexpr auto narrow(std::int64_t value) -> T {
+    if constexpr (mode == Overflow::saturate) {
+        value = std::clamp<std::int64_t>(value, min_v<T>, max_v<T>);
+    }
+    return static_cast<T>(value);
+}
+
+// Runs `simd_op` over full registers of `V` and `scalar_op` over the tail
+template <typename T, typename V = simd_t<T>, typename SimdOp,
+          typename ScalarOp>
+void binary(std::span<const T> a, std::span<const T> b, std::span<T> out,
+            SimdOp simd_op, ScalarOp scalar_op) {
+    constexpr std::size_t width = V::size();
+    std::size_t i = 0;
+    for (; i + width <= out.size(); i += width) {
+        V va{a.data() + i, stdx::element_aligned};
+        V vb{b.data() + i, stdx::element_aligned};
+        simd_op(va, vb).copy_to(out.data() + i, stdx::element_aligned);
+    }
+    for (; i < out.size(); i++) {
+        out[i] = scalar_op(a[i], b[i]);
+    }
+}
+
+} // namespace detail
+
+// out[i] = a[i] + b[i]
+template <Overflow mode, narrow_integer T>
+void add(std::span<const T> a, std::span<const T> b, std::span<T> out) {
+    using V = detail::simd_t<T>;
+    detail::binary(
+        a, b, out,
+        [](V x, V y) {
+            V sum = x + y;
+            if constexpr (mode == Overflow::saturate) {
+                if constexpr (std::is_signed_v<T>) {
+                    // overflow iff both operands differ in sign from the sum
+                    auto overflow = ((x ^ sum) & (y ^ sum)) < 0;
+                    where(overflow, sum) = V{detail::max_v<T>};
+                    where(overflow && x < 0, sum) = V{detail::min_v<T>};
+                } else {
+                    where(sum < x, sum) = V{detail::max_v<T>};
+                }
+            }
+            return sum;
+        },
+        [](T x, T y) {
+            return detail::narrow<mode, T>(std::int64_t{x} + y);
+        });
+}
+
+// out[i] = a[i] - b[i]
+template <Overflow mode, narrow_integer T>
+void sub(std::span<const T> a, std::span<const T> b, std::span<T> out) {
+    using V = detail::simd_t<T>;
+    detail::binary(
+        a, b, out,
+        [](V x, V y) {
+            V diff = x - y;
+            if constexpr (mode == Overflow::saturate) {
+                if constexpr (std::is_signed_v<T>) {
+                    // overflow iff the operands differ in sign and the result
+                    // differs in sign from `x`
+                    auto overflow = ((x ^ y) & (x ^ diff)) < 0;
+                    where(overflow, diff) = V{detail::max_v<T>};
+                    where(overflow && x < 0, diff) = V{detail::min_v<T>};
+                } else {
+                    where(x < y, diff) = V{0};
+                }
+            }
+            return diff;
+        },
+        [](T x, T y) {
+            return detail::narrow<mode, T>(std::int64_t{x} - y);
+        });
+}
+
+// out[i] = a[i] * b[i]
+// - saturate widens to 32 bits 16 lanes at a time, so the products of one
+//   step still fit in a fixed_size simd
+template <Overflow mode, narrow_integer T>
+void mul(std::span<const T> a, std::span<const T> b, std::span<T> out) {
+    auto scalar = [](T x, T y) {
+        return detail::narrow<mode, T>(std::int64_t{x} * y);
+    };
+    if constexpr (mode == Overflow::wrap) {
+        using V = detail::simd_t<T>;
+        detail::binary(a, b, out, [](V x, V y) { return V{x * y}; }, scalar);
+    } else {
+        using V = stdx::fixed_size_simd<T, 16>;
+        using wide_int = std::conditional_t<std::is_signed_v<T>, std::int32_t,
+                                            std::uint32_t>;
+        using wide_t = stdx::fixed_size_simd<wide_int, 16>;
+        detail::binary<T, V>(
+            a, b, out,
+            [](V x, V y) {
+                auto product = stdx::static_simd_cast<wide_t>(x) *
+                               stdx::static_simd_cast<wide_t>(y);
+                product = stdx::clamp(product, wide_t{detail::min_v<T>},
+                                      wide_t{detail::max_v<T>});
+                return stdx::static_simd_cast<V>(product);
+            },
+            scalar);
+    }
+}
+
+// out[i] = min(a[i], b[i]) (never overflows)
+template <narrow_integer T>
+void min(std::span<const T> a, std::span<const T> b, std::span<T> out) {
+    using V = detail::simd_t<T>;
+    detail::binary(
+        a, b, out, [](V x, V y) { return stdx::min(x, y); },
+        [](T x, T y) { return std::min(x, y); });
+}
+
+// out[i] = max(a[i], b[i]) (never overflows)
+template <narrow_integer T>
+void max(std::span<const T> a, std::span<const T> b, std::span<T> out) {
+    using V = detail::simd_t<T>;
+    detail::binary(
+        a, b, out, [](V x, V y) { return stdx::max(x, y); },
+        [](T x, T y) { return std::max(x, y); });
+}
+
+// out[i] = |a[i]|
+// - wrap:     |min| stays min (two's complement)
+// - saturate: |min| becomes max
+template <Overflow mode, narrow_integer T>
+    requires std::is_signed_v<T>
+void abs(std::span<const T> a, std::span<T> out) {
+    using V = detail::simd_t<T>;
+    detail::binary(
+        a, a, out,
+        [](V x, V) {
+            V result = x;
+            where(x < 0, result) = -x;
+            if constexpr (mode == Overflow::saturate) {
+                where(result < 0, result) = V{detail::max_v<T>};
+            }
+            return result;
+        },
+        [](T x, T) {
+            return detail::narrow<mode, T>(x < 0 ? -std::int64_t{x} : x);
+        });
+}
+
+} // namespace narrow_int
@@ -0,0 +1,123 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <print>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "nonfinite/nonfinite.hpp"
+
+using namespace std;
+
+#define PRINT_VAR(var) std::println("{} = {}", #var, var);
+
+constexpr size_t num_values = 32'000'000;
+constexpr int reps = 5;
+
+// ~1 in `every` values is NaN, +Inf or -Inf
+template <typename T> //
+auto make_data(size_t every) -> vector<T> {
+    mt19937_64 rng{10};
+    uniform_real_distribution<T> dist{-1e6, 1e6};
+    uniform_int_distribution<size_t> pick{0, every - 1};
+    vector<T> data(num_values);
+    for (auto &v : data) {
+        v = dist(rng);
+        switch (pick(rng)) {
+        case 0:
+            v = numeric_limits<T>::quiet_NaN();
+            break;
+        case 1:
+            v = numeric_limits<T>::infinity();
+            break;
+        case 2:
+            v = -numeric_limits<T>::infinity();
+            break;
+        default:
+            break;
+        }
+    }
+    return data;
+}
+
+// The baseline: std::isfinite per element, classify and replace in one pass
+template <typename T> //
+auto isfinite_loop(span<T> values) -> nonfinite::Counts {
+    nonfinite::Counts counts;
+    for (auto &v : values) {
+        if (!std::isfinite(v)) {
+            if (std::isnan(v)) {
+                counts.nan++;
+                v = 0;
+            } else if (v > 0) {
+                counts.pos_inf++;
+                v = numeric_limits<T>::max();
+            } else {
+                counts.neg_inf++;
+                v = numeric_limits<T>::lowest();
+            }
+        }
+    }
+    return counts;
+}
+
+template <typename T> //
+void run(const char *label, size_t every) {
+    auto input = make_data<T>(every);
+    vector<T> data;
+    auto reset = [&] { data = input; };
+    println("\n{}:", label);
+
+    nonfinite::Counts expected;
+    auto t = bench::time_best(reps, reset, [&] {
+        expected = isfinite_loop(span<T>{data});
+    });
+    auto gb = static_cast<double>(num_values * sizeof(T)) / 1e9;
+    println("  {:<32} {:>8.2f} ms  {:>6.2f} GB/s", "std::isfinite loop",
+            t * 1e3, gb / t);
+    auto sanitized = data;
+
+    nonfinite::Counts counts;
+    t = bench::time_best(reps, [&] {
+        counts = nonfinite::count(span<const T>{input});
+    });
+    println("  {:<32} {:>8.2f} ms  {:>6.2f} GB/s", "nonfinite::count", t * 1e3,
+            gb / t);
+
+    vector<uint64_t> mask(nonfinite::mask_words(num_values));
+    t = bench::time_best(reps, reset, [&] {
+        counts = nonfinite::sanitize(span<T>{data}, {}, span{mask});
+    });
+    println("  {:<32} {:>8.2f} ms  {:>6.2f} GB/s",
+            "nonfinite::sanitize (+ mask)", t * 1e3, gb / t);
+
+    println("  nan {}, +inf {}, -inf {}; matches isfinite loop: {}",
+            counts.nan, counts.pos_inf, counts.neg_inf,
+            counts.nan == expected.nan && counts.pos_inf == expected.pos_inf &&
+                counts.neg_inf == expected.neg_inf && data == sanitized);
+}
+
+auto main() -> int {
+    println("Nonfinite - bulk NaN/Inf classification and sanitization");
+
+    println("\nthe basic_concepts_ii values:");
+    // `0.0 / 0`, `5.0 / 0` and `-5.0 / 0`, without division by zero
+    constexpr auto inf = numeric_limits<double>::infinity();
+    vector<double> values{numeric_limits<double>::quiet_NaN(), inf, -inf,
+                          numeric_limits<double>::quiet_NaN(), 1.5};
+    auto counts = nonfinite::sanitize(span<double>{values});
+    PRINT_VAR(counts.nan)
+    PRINT_VAR(counts.pos_inf)
+    PRINT_VAR(counts.neg_inf)
+    PRINT_VAR(values[0])
+    PRINT_VAR(values[1])
+
+    println("\n{} values per buffer", num_values);
+    run<float>("float, clean", numeric_limits<size_t>::max());
+    run<float>("float, ~0.1% non-finite", 3'000);
+    run<float>("float, ~10% non-finite", 30);
+    run<double>("double, ~0.1% non-finite", 3'000);
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+// Bulk NaN / +Inf / -Inf classification and sanitization
+//
+// basic_concepts_ii produces `nan` from `0.0 / 0`, `inf` from `5.0 / 0`, and
+// shows NaN != NaN. For an ingest buffer we want, in one pass over the data:
+//   - how many NaN, +Inf and -Inf values there are
+//   - where they are (a bitmask, bit `i % 64` of word `i / 64`)
+//   - the buffer with each of them replaced by a chosen value
+//
+// Classification looks at the bits, not at float comparisons: a value is
+// non-finite iff its exponent field is all ones (mantissa != 0 -> NaN,
+// mantissa == 0 -> infinity). Integer tests can't be folded away by
+// `-ffinite-math-only` (part of `-ffast-math`) the way `x != x` and
+// `std::isnan` can, and they compile to packed integer compares.
+//
+// The scan is a branch-free loop over 64-element blocks (auto-vectorized);
+// the fix-up only runs for blocks whose mask word is non-zero, so clean data
+// is read once and never written.
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+namespace nonfinite {
+
+struct Counts {
+    std::size_t nan = 0;
+    std::size_t pos_inf = 0;
+    std::size_t neg_inf = 0;
+
+    [[nodiscard]] auto total() const -> std::size_t {
+        return nan + pos_inf + neg_inf;
+    }
+};
+
+template <std::floating_point T> struct Replacement {
+    T nan = 0;
+    T pos_inf = std::numeric_limits<T>::max();
+    T neg_inf = std::numeric_limits<T>::lowest();
+};
+
+constexpr auto mask_words(std::size_t n) -> std::size_t {
+    return (n + 63) / 64;
+}
+
+namespace detail {
+
+template <std::floating_point T>
+using bits_t = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+
+template <std::floating_point T>
+constexpr bits_t<T> sign_bit = bits_t<T>{1} << (sizeof(T) * 8 - 1);
+template <std::floating_point T>
+constexpr bits_t<T> exponent_bits = std::bit_cast<bits_t<T>>(
+    std::numeric_limits<T>::infinity());
+
+template <std::floating_point T>
+constexpr auto is_nonfinite(T value) -> bool {
+    return (std::bit_cast<bits_t<T>>(value) & ~sign_bit<T>) >= exponent_bits<T>;
+}
+
+// Scan `values` (at most 64) into a non-finite mask word, adding to `counts`
+// - the counting loop keeps its counters as wide as `T`, so it vectorizes at
+//   the full lane count; the mask word is only built for blocks that
+//   actually contain a non-finite value
+template <std::floating_point T>
+auto scan_block(std::span<const T> values, Counts &counts) -> std::uint64_t {
+    using U = bits_t<T>;
+    U nan = 0;
+    U inf = 0;
+    U neg_inf = 0;
+    for (std::size_t j = 0; j < values.size(); j++) {
+        auto bits = std::bit_cast<U>(values[j]);
+        auto magnitude = bits & ~sign_bit<T>;
+        U is_inf = magnitude == exponent_bits<T> ? 1 : 0;
+        nan += magnitude > exponent_bits<T> ? 1 : 0;
+        inf += is_inf;
+        neg_inf += is_inf & (bits >> (sizeof(T) * 8 - 1));
+    }
+    if (nan + inf == 0) {
+        return 0;
+    }
+    counts.nan += nan;
+    counts.pos_inf += inf - neg_inf;
+    counts.neg_inf += neg_inf;
+    std::uint64_t word = 0;
+    for (std::size_t j = 0; j < values.size(); j++) {
+        word |= std::uint64_t{is_nonfinite(values[j])} << j;
+    }
+    return word;
+}
+
+} // namespace detail
+
+// Count only
+template <std::floating_point T> //
+auto count(std::span<const T> values) -> Counts {
+    Counts counts;
+    for (std::size_t i = 0; i < values.size(); i += 64) {
+        detail::scan_block(values.subspan(i, std::min<std::size_t>(
+                                                 64, values.size() - i)),
+                           counts);
+    }
+    return counts;
+}
+
+// Count, and write the non-finite positions into `mask`
+// (`mask_words(values.size())` words)
+template <std::floating_point T>
+auto locate(std::span<const T> values, std::span<std::uint64_t> mask)
+    -> Counts {
+    Counts counts;
+    for (std::size_t i = 0; i < values.size(); i += 64) {
+        mask[i / 64] = detail::scan_block(
+            values.subspan(i, std::min<std::size_t>(64, values.size() - i)),
+            counts);
+    }
+    return counts;
+}
+
+// Count, optionally locate (pass an empty `mask` to skip), and replace every
+// NaN / +Inf / -Inf in place
+template <std::floating_point T>
+auto sanitize(std::span<T> values, const Replacement<T> &replacement = {},
+              std::span<std::uint64_t> mask = {}) -> Counts {
+    Counts counts;
+    for (std::size_t i = 0; i < values.size(); i += 64) {
+        auto block =
+            values.subspan(i, std::min<std::size_t>(64, values.size() - i));
+        auto word = detail::scan_block(std::span<const T>{block}, counts);
+        if (!mask.empty()) {
+            mask[i / 64] = word;
+        }
+        for (; word != 0; word &= word - 1) {
+            auto &v = block[static_cast<std::size_t>(std::countr_zero(word))];
+            auto bits = std::bit_cast<detail::bits_t<T>>(v);
+            if ((bits & ~detail::sign_bit<T>) != detail::exponent_bits<T>) {
+                v = replacement.nan;
+            } else {
+                v = (bits & detail::sign_bit<T>) != 0 ? replacement.neg_inf
+                                                       : replacement.pos_inf;
+            }
+        }
+    }
+    return counts;
+}
+
+} // namespace nonfinite
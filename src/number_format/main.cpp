@@ -0,0 +1,120 @@
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <print>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "number_format/number_format.hpp"
+#include "output/output.hpp"
+
+using namespace std;
+
+#define PRINT_VAR(var) NUMBER_PRINT_VAR(var)
+
+constexpr size_t num_values = 5'000'000;
+constexpr int reps = 5;
+
+// Every method produces the same newline-separated text in memory, so only
+// formatting is measured
+template <typename T> //
+void run(const char *label, const vector<T> &values) {
+    println("\n{}:", label);
+    string reference;
+
+    auto t = bench::time_best(reps, [&] {
+        ostringstream os;
+        for (auto v : values) {
+            os << v << '\n';
+        }
+        bench::do_not_optimize(os.str().size());
+    });
+    bench::report("std::ostringstream <<", t, num_values, "values");
+
+    t = bench::time_best(reps, [&] {
+        reference.clear();
+        auto out = back_inserter(reference);
+        for (auto v : values) {
+            out = format_to(out, "{}\n", v);
+        }
+    });
+    bench::report("std::format_to (back_inserter)", t, num_values, "values");
+
+    string text;
+    t = bench::time_best(reps, [&] {
+        text.resize(values.size() * (number_format::max_chars<T> + 1));
+        char *out = text.data();
+        char *last = out + text.size();
+        for (auto v : values) {
+            out = to_chars(out, last, v).ptr;
+            *out++ = '\n';
+        }
+        text.resize(static_cast<size_t>(out - text.data()));
+    });
+    bench::report("std::to_chars loop", t, num_values, "values");
+
+    t = bench::time_best(reps, [&] {
+        text.resize(values.size() * (number_format::max_chars<T> + 1));
+        char *last = number_format::write_all(
+            text.data(), span<const T>{values}, '\n');
+        text.resize(static_cast<size_t>(last - text.data()));
+    });
+    bench::report("number_format::write_all", t, num_values, "values");
+    println("  {:.1f} MB of text; matches std::format: {}",
+            static_cast<double>(text.size()) / 1e6, text == reference);
+}
+
+auto main() -> int {
+    println("Number format - batched integer/float to text");
+
+    // the basic_concepts_i values, through the drop-in PRINT_VAR
+    println("\nNUMBER_PRINT_VAR:");
+    int i = -2147483648;
+    unsigned x = 4294967295U;
+    double result = 0.1 + 0.2;
+    float comp = 1.0F / 3;
+    bool util_comp = true;
+    PRINT_VAR(i)
+    PRINT_VAR(x)
+    PRINT_VAR(result)
+    PRINT_VAR(comp)
+    PRINT_VAR(util_comp)
+    output::thread_sink().flush();
+
+    println("\n{} values per run", num_values);
+    mt19937_64 rng{12};
+
+    // magnitudes spread over all digit counts
+    vector<int64_t> ints(num_values);
+    for (auto &v : ints) {
+        v = static_cast<int64_t>(rng() >> (rng() % 64));
+        v = (rng() & 1U) != 0 ? v : -v;
+    }
+    run("int64_t, 1-19 digits", ints);
+
+    vector<uint32_t> small(num_values);
+    uniform_int_distribution<uint32_t> small_dist{0, 9'999};
+    for (auto &v : small) {
+        v = small_dist(rng);
+    }
+    run("uint32_t, 1-4 digits", small);
+
+    vector<double> doubles(num_values);
+    uniform_real_distribution<double> real_dist{-1e6, 1e6};
+    for (auto &v : doubles) {
+        v = real_dist(rng);
+    }
+    run("double, shortest round-trip", doubles);
+
+    vector<float> floats(num_values);
+    uniform_real_distribution<float> float_dist{0, 1};
+    for (auto &v : floats) {
+        v = float_dist(rng);
+    }
+    run("float, shortest round-trip", floats);
+}
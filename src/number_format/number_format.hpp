@@ -0,0 +1,188 @@
+#pragma once
+
+// Numeric-to-text formatting without the format-string machinery
+//
+// `std::format("{}", x)` and `os << x` parse a format spec (or consult the
+// stream's flags and locale) for every value, and append through a type-erased
+// iterator or a `streambuf`. For dumping millions of numbers, that overhead
+// costs more than converting the digits.
+//
+// `number_format` writes numbers straight into a caller's `char` buffer:
+//   - integers: digit count up front (from the bit width), then two digits
+//     per step from a 200-byte digit-pair table, written back to front
+//   - floats: `std::to_chars` without a precision, i.e. the shortest text
+//     that parses back to the same value (same digits as `std::format("{}")`)
+//
+// Each value has a fixed upper bound on its length (`max_chars<T>`), so a
+// batch of `n` values needs no bounds checks: reserve `n * (max_chars<T> + 1)`
+// chars once and write them all (`write_all`). `print_all` / `print_var` do the
+// same into an `output::Sink`; `NUMBER_PRINT_VAR` is a drop-in for the
+// `PRINT_VAR` macros.
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "output/output.hpp"
+
+namespace number_format {
+
+// Arithmetic types printed as numbers (`bool` and the character types are
+// printed as text by `std::format`, so they are left to it)
+template <typename T>
+concept number =
+    std::floating_point<T> ||
+    (std::integral<T> && !std::same_as<T, bool> && !std::same_as<T, char> &&
+     !std::same_as<T, wchar_t> && !std::same_as<T, char8_t> &&
+     !std::same_as<T, char16_t> && !std::same_as<T, char32_t>);
+
+// Upper bound on the chars written for one value
+// - integers: digits10 + 1 digits, plus a sign
+// - floats: max_digits10 digits, plus sign, point, 'e', exponent sign and up
+//   to 5 exponent digits
+template <number T>
+inline constexpr std::size_t max_chars =
+    std::integral<T>
+        ? static_cast<std::size_t>(std::numeric_limits<T>::digits10) + 2
+        : static_cast<std::size_t>(std::numeric_limits<T>::max_digits10) + 9;
+
+namespace detail {
+
+// "00" "01" ... "99"
+inline constexpr auto digit_pairs = [] {
+    std::array<char, 200> pairs{};
+    for (std::size_t i = 0; i < 100; i++) {
+        pairs[2 * i] = static_cast<char>('0' + (i / 10));
+        pairs[(2 * i) + 1] = static_cast<char>('0' + (i % 10));
+    }
+    return pairs;
+}();
+
+inline constexpr auto powers_of_10 = [] {
+    std::array<std::uint64_t, 20> powers{};
+    std::uint64_t p = 1;
+    for (auto &power : powers) {
+        power = p;
+        p *= 10;
+    }
+    return powers;
+}();
+
+// Decimal digits of `value`: log10 estimated from the bit width
+// (1233 / 4096 ~ log10(2)), then corrected by one comparison
+// (`| 1` maps 0 to 1 and never changes the digit count)
+constexpr auto count_digits(std::uint64_t value) -> std::size_t {
+    value |= 1U;
+    auto estimate =
+        (static_cast<std::size_t>(std::bit_width(value)) * 1233) >> 12U;
+    return estimate + 1 - static_cast<std::size_t>(
+                              value < powers_of_10[estimate]);
+}
+
+inline auto write_unsigned(char *out, std::uint64_t value) -> char * {
+    char *last = out + count_digits(value);
+    char *p = last;
+    while (value >= 100) {
+        p -= 2;
+        std::memcpy(p, &digit_pairs[2 * (value % 100)], 2);
+        value /= 100;
+    }
+    if (value >= 10) {
+        std::memcpy(p - 2, &digit_pairs[2 * value], 2);
+    } else {
+        *(p - 1) = static_cast<char>('0' + value);
+    }
+    return last;
+}
+
+} // namespace detail
+
+// Write `value` at `out` (room for `max_chars<T>` required); returns one past
+// the last char written
+template <number T> //
+auto write(char *out, T value) -> char * {
+    if constexpr (std::floating_point<T>) {
+        return std::to_chars(out, out + max_chars<T>, value).ptr;
+    } else if constexpr (std::is_signed_v<T>) {
+        using U = std::make_unsigned_t<T>;
+        auto magnitude = static_cast<U>(value);
+        if (value < 0) {
+            *out++ = '-';
+            magnitude = static_cast<U>(U{0} - magnitude);
+        }
+        return detail::write_unsigned(out, magnitude);
+    } else {
+        return detail::write_unsigned(out, value);
+    }
+}
+
+// Write all `values`, each followed by `separator`, at `out`
+// (room for `values.size() * (max_chars<T> + 1)` required)
+template <number T>
+auto write_all(char *out, std::span<const T> values, char separator)
+    -> char * {
+    for (auto value : values) {
+        out = write(out, value);
+        *out++ = separator;
+    }
+    return out;
+}
+
+// Same, as a string
+template <number T>
+auto format_all(std::span<const T> values, char separator) -> std::string {
+    std::string text;
+    // (C++23 `resize_and_overwrite` would skip zero-filling the buffer)
+    text.resize(values.size() * (max_chars<T> + 1));
+    auto *last = write_all(text.data(), values, separator);
+    text.resize(static_cast<std::size_t>(last - text.data()));
+    return text;
+}
+
+// Append `values` to `sink` in sink-sized batches
+template <number T>
+void print_all(output::Sink &sink, std::span<const T> values,
+               char separator = '\n') {
+    constexpr std::size_t per_value = max_chars<T> + 1;
+    auto batch = std::max<std::size_t>(1, sink.capacity() / per_value);
+    for (std::size_t i = 0; i < values.size(); i += batch) {
+        auto chunk = values.subspan(i, std::min(batch, values.size() - i));
+        sink.append(chunk.size() * per_value, [&](char *out) {
+            return write_all(out, chunk, separator);
+        });
+    }
+}
+
+// "<name> = <value>\n"; anything that isn't a `number` goes through
+// `std::format`
+template <typename T>
+void print_var(output::Sink &sink, std::string_view name, const T &value) {
+    if constexpr (number<T>) {
+        sink.append(name.size() + 3 + max_chars<T> + 1, [&](char *out) {
+            out = std::copy(name.begin(), name.end(), out);
+            out = std::copy_n(" = ", 3, out);
+            out = write(out, value);
+            *out++ = '\n';
+            return out;
+        });
+    } else {
+        sink.println("{} = {}", name, value);
+    }
+}
+
+} // namespace number_format
+
+// Drop-in for the `PRINT_VAR` macros used by the other executables:
+//   #define PRINT_VAR(var) NUMBER_PRINT_VAR(var)
+#define NUMBER_PRINT_VAR(var)                                                  \
+    number_format::print_var(output::thread_sink(), #var, var);
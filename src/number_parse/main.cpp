@@ -0,0 +1,120 @@
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <print>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "number_format/number_format.hpp"
+#include "number_parse/number_parse.hpp"
+
+using namespace std;
+
+#define PRINT_VAR(var) std::println("{} = {}", #var, var);
+
+constexpr size_t num_values = 5'000'000;
+constexpr int reps = 5;
+
+// One number per line
+template <typename T> //
+auto make_text(const vector<T> &values) -> string {
+    return number_format::format_all(span<const T>{values}, '\n');
+}
+
+template <typename T> //
+void run(const char *label, const string &text, const vector<T> &expected) {
+    println("\n{} ({:.1f} MB):", label, static_cast<double>(text.size()) / 1e6);
+    auto bytes = static_cast<double>(text.size());
+    vector<T> out;
+    out.reserve(expected.size());
+
+    auto t = bench::time_best(reps, [&] { out.clear(); }, [&] {
+        istringstream is{text};
+        T v{};
+        while (is >> v) {
+            out.push_back(v);
+        }
+    });
+    bench::report("std::istringstream >>", t, bytes, "B");
+    auto istream_ok = out == expected;
+
+    t = bench::time_best(reps, [&] { out.clear(); }, [&] {
+        const char *p = text.data();
+        const char *last = p + text.size();
+        while (p != last) {
+            T v{};
+            auto [ptr, ec] = from_chars(p, last, v);
+            if (ec != errc{}) {
+                break;
+            }
+            out.push_back(v);
+            p = ptr + 1;
+        }
+    });
+    bench::report("std::from_chars loop", t, bytes, "B");
+    auto from_chars_ok = out == expected;
+
+    t = bench::time_best(reps, [&] { out.clear(); },
+                         [&] { number_parse::parse(text, out); });
+    bench::report("number_parse::parse", t, bytes, "B");
+    println("  correct: istream {}, from_chars {}, number_parse {}",
+            istream_ok, from_chars_ok, out == expected);
+}
+
+auto main() -> int {
+    println("Number parse - bulk text to fixed-width numbers");
+
+    // basic_concepts_ii: streams read `int8_t` / `uint8_t` as characters
+    println("\n\"2,32,56\" into int8_t:");
+    istringstream is{"2,32,56"};
+    int8_t num = 0;
+    is >> num;
+    PRINT_VAR(+num)
+    vector<int8_t> nums;
+    number_parse::parse("2,32,56", nums);
+    PRINT_VAR(+nums[0])
+    PRINT_VAR(+nums[2])
+    vector<uint8_t> too_big;
+    auto [ptr, ec] = number_parse::parse("2,32,560", too_big);
+    PRINT_VAR(ec == errc::result_out_of_range)
+
+    println("\n{} values per run", num_values);
+    mt19937_64 rng{13};
+
+    vector<int32_t> ints(num_values);
+    uniform_int_distribution<int32_t> int_dist{-1'000'000, 1'000'000};
+    for (auto &v : ints) {
+        v = int_dist(rng);
+    }
+    run("int32_t, up to 7 digits", make_text(ints), ints);
+
+    // microsecond timestamps: 16 digits, two SWAR steps
+    vector<uint64_t> stamps(num_values);
+    uint64_t now = 1'700'000'000'000'000;
+    for (auto &v : stamps) {
+        now += rng() % 1'000;
+        v = now;
+    }
+    run("uint64_t timestamps, 16 digits", make_text(stamps), stamps);
+
+    // prices with two decimals: all on the exact fast path
+    vector<double> prices(num_values);
+    uniform_int_distribution<int64_t> cents{0, 10'000'000};
+    for (auto &v : prices) {
+        v = static_cast<double>(cents(rng)) / 100;
+    }
+    run("double, 2 decimals", make_text(prices), prices);
+
+    // shortest round-trip text of arbitrary doubles: mostly 16-17 digits,
+    // so most values take the from_chars fallback
+    vector<double> reals(num_values);
+    uniform_real_distribution<double> real_dist{-1e6, 1e6};
+    for (auto &v : reals) {
+        v = real_dist(rng);
+    }
+    run("double, shortest round-trip", make_text(reals), reals);
+}
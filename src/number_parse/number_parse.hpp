@@ -0,0 +1,353 @@
+#pragma once
+
+// Bulk text-to-number parsing
+//
+// Reading a large file of numbers with `std::istream >> x` goes through the
+// stream's sentry, locale and `num_get` for every value; a `std::from_chars`
+// loop is much leaner but still converts one digit at a time. This parses
+// fields separated by ',' or whitespace (empty fields are skipped, so "1, 2"
+// and CRLF line ends work) straight into the fixed-width types:
+//   - delimiters: a SIMD register of bytes is compared at once, and the
+//     field ends at the first set lane
+//   - digits: the field length is known, so its digits are converted 8 at a
+//     time as one 64-bit integer (SWAR) - a short head is right-aligned in
+//     '0' padding, validated with two masks and combined with three
+//     multiplies; no per-digit branches
+//   - floats: plain decimals whose digits fit the mantissa (ex. "-12.375")
+//     are exact as one integer / power-of-10 division; anything else
+//     (exponents, 17-digit round-trip text, "inf", ...) falls back to
+//     `std::from_chars`
+//
+// Accepts exactly what `std::from_chars` accepts for a whole field (no '+',
+// '-' only for signed and floating-point types). A field with trailing junk
+// is `std::errc::invalid_argument`, one out of `T`'s range
+// `std::errc::result_out_of_range`; `ptr` points at the offending field.
+//
+// `StreamParser` accepts the text in arbitrary chunks (ex. `fread` blocks) and
+// keeps a field split across two chunks until it is complete.
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <experimental/simd>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include "number_format/number_format.hpp"
+
+namespace number_parse {
+
+namespace stdx = std::experimental;
+
+using number_format::number;
+
+namespace detail {
+
+using byte_simd = stdx::native_simd<unsigned char>;
+
+constexpr auto is_delimiter(char c) -> bool {
+    return static_cast<unsigned char>(c) <= ' ' || c == ',';
+}
+
+// First delimiter in [p, last), or `last`
+inline auto find_delimiter(const char *p, const char *last) -> const char * {
+    constexpr std::size_t width = byte_simd::size();
+    const byte_simd space{static_cast<unsigned char>(' ')};
+    const byte_simd comma{static_cast<unsigned char>(',')};
+    while (static_cast<std::size_t>(last - p) >= width) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        byte_simd bytes{reinterpret_cast<const unsigned char *>(p),
+                        stdx::element_aligned};
+        auto hit = (bytes <= space) || (bytes == comma);
+        if (stdx::any_of(hit)) {
+            return p + stdx::find_first_set(hit);
+        }
+        p += width;
+    }
+    while (p != last && !is_delimiter(*p)) {
+        p++;
+    }
+    return p;
+}
+
+inline auto load8(const char *p) -> std::uint64_t {
+    std::uint64_t chunk = 0;
+    std::memcpy(&chunk, p, 8);
+    if constexpr (std::endian::native == std::endian::big) {
+        chunk = std::byteswap(chunk);
+    }
+    return chunk;
+}
+
+// All 8 bytes are '0'..'9': high nibbles are 3, and adding 6 doesn't carry
+// out of any low nibble
+constexpr auto all_digits(std::uint64_t chunk) -> bool {
+    constexpr std::uint64_t high = 0xF0F0'F0F0'F0F0'F0F0;
+    constexpr std::uint64_t zeros = 0x3030'3030'3030'3030;
+    constexpr std::uint64_t sixes = 0x0606'0606'0606'0606;
+    return (chunk & high) == zeros && ((chunk + sixes) & high) == zeros;
+}
+
+// Value of 8 ASCII digits (first digit in the lowest byte): combine adjacent
+// bytes, then pairs, then quads, each with one multiply
+constexpr auto eight_digits(std::uint64_t chunk) -> std::uint64_t {
+    chunk = ((chunk & 0x0F0F'0F0F'0F0F'0F0F) * 2561) >> 8U;
+    chunk = ((chunk & 0x00FF'00FF'00FF'00FF) * 6553601) >> 16U;
+    return ((chunk & 0x0000'FFFF'0000'FFFF) * 42949672960001) >> 32U;
+}
+
+// Largest count of decimal digits that always fits a `uint64_t`
+inline constexpr std::size_t max_fast_digits = 19;
+
+inline constexpr auto powers_of_10 = [] {
+    std::array<std::uint64_t, max_fast_digits + 1> powers{};
+    std::uint64_t p = 1;
+    for (auto &power : powers) {
+        power = p;
+        p *= 10;
+    }
+    return powers;
+}();
+
+// The `n` (1..8) chars at `p` right-aligned in a chunk of '0's, so any
+// field length goes through the same branchless 8-digit conversion; chars
+// up to `limit` may be read past the field
+inline auto load_padded(const char *p, std::size_t n, const char *limit)
+    -> std::uint64_t {
+    std::uint64_t chunk = 0;
+    if (limit - p >= 8) {
+        chunk = load8(p);
+    } else {
+        std::array<char, 8> tmp{};
+        std::memcpy(tmp.data(), p, n);
+        chunk = load8(tmp.data());
+    }
+    auto pad = 8 * (8 - n);
+    constexpr std::uint64_t zeros = 0x3030'3030'3030'3030;
+    return (chunk << pad) | ((zeros >> (63 - pad)) >> 1U);
+}
+
+// Value of the `n` (1..19) chars at `p`; false if any isn't a digit
+inline auto parse_digits(const char *p, std::size_t n, const char *limit,
+                         std::uint64_t &value) -> bool {
+    auto head = ((n - 1) % 8) + 1;
+    auto chunk = load_padded(p, head, limit);
+    if (!all_digits(chunk)) {
+        return false;
+    }
+    value = eight_digits(chunk);
+    for (p += head, n -= head; n != 0; p += 8, n -= 8) {
+        chunk = load8(p);
+        if (!all_digits(chunk)) {
+            return false;
+        }
+        value = (value * 100'000'000) + eight_digits(chunk);
+    }
+    return true;
+}
+
+template <typename T> //
+auto from_chars_whole(const char *first, const char *last, T &value)
+    -> std::errc {
+    auto [ptr, ec] = std::from_chars(first, last, value);
+    return ptr == last ? ec : std::errc::invalid_argument;
+}
+
+template <typename T>
+auto parse_integer(const char *first, const char *last, const char *limit,
+                   T &value) -> std::errc {
+    const char *p = first;
+    bool negative = false;
+    if constexpr (std::is_signed_v<T>) {
+        negative = p != last && *p == '-';
+        p += negative ? 1 : 0;
+    }
+    auto n = static_cast<std::size_t>(last - p);
+    if (n == 0 || n > max_fast_digits) {
+        // (may still fit with leading zeros)
+        return from_chars_whole(first, last, value);
+    }
+    std::uint64_t magnitude = 0;
+    if (!parse_digits(p, n, limit, magnitude)) {
+        return std::errc::invalid_argument;
+    }
+    using U = std::make_unsigned_t<T>;
+    auto max = static_cast<std::uint64_t>(std::numeric_limits<T>::max()) +
+               (negative ? 1U : 0U);
+    if (magnitude > max) {
+        return std::errc::result_out_of_range;
+    }
+    auto bits = static_cast<U>(magnitude);
+    value = static_cast<T>(negative ? static_cast<U>(U{0} - bits) : bits);
+    return {};
+}
+
+// Powers of 10 that `T` represents exactly
+template <typename T>
+inline constexpr auto exact_powers_of_10 = [] {
+    std::array<T, std::is_same_v<T, float> ? 11 : 23> powers{};
+    T p = 1;
+    for (auto &power : powers) {
+        power = p;
+        p *= 10;
+    }
+    return powers;
+}();
+
+// Fast path (Clinger) for "[-]digits[.digits]": the mantissa and
+// 10^fraction_digits are both exact in `T`, so one correctly rounded
+// division gives the correctly rounded result; false if the field doesn't
+// qualify
+template <typename T>
+auto parse_plain_decimal(const char *p, const char *last, const char *limit,
+                         T &value) -> bool {
+    bool negative = p != last && *p == '-';
+    p += negative ? 1 : 0;
+    const char *dot = std::find(p, last, '.');
+    auto int_digits = static_cast<std::size_t>(dot - p);
+    auto frac_digits =
+        dot == last ? 0 : static_cast<std::size_t>(last - dot - 1);
+    auto digits = int_digits + frac_digits;
+    if (digits == 0 || digits > max_fast_digits ||
+        frac_digits >= exact_powers_of_10<T>.size()) {
+        return false;
+    }
+    std::uint64_t int_part = 0;
+    std::uint64_t frac_part = 0;
+    if ((int_digits != 0 && !parse_digits(p, int_digits, limit, int_part)) ||
+        (frac_digits != 0 &&
+         !parse_digits(dot + 1, frac_digits, limit, frac_part))) {
+        return false;
+    }
+    auto mantissa = (int_part * powers_of_10[frac_digits]) + frac_part;
+    if (mantissa > (std::uint64_t{1} << std::numeric_limits<T>::digits)) {
+        return false;
+    }
+    auto magnitude =
+        static_cast<T>(mantissa) / exact_powers_of_10<T>[frac_digits];
+    value = negative ? -magnitude : magnitude;
+    return true;
+}
+
+template <typename T>
+auto parse_float(const char *first, const char *last, const char *limit,
+                 T &value) -> std::errc {
+    if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+        if (parse_plain_decimal(first, last, limit, value)) {
+            return {};
+        }
+    }
+    // exponents, long mantissas, "inf"/"nan", or invalid
+    return from_chars_whole(first, last, value);
+}
+
+// Parse [first, last); reading ahead up to `limit` is allowed
+template <number T>
+auto parse_field(const char *first, const char *last, const char *limit,
+                 T &value) -> std::errc {
+    if constexpr (std::floating_point<T>) {
+        return parse_float(first, last, limit, value);
+    } else {
+        return parse_integer(first, last, limit, value);
+    }
+}
+
+} // namespace detail
+
+// Parse one whole field [first, last)
+template <number T>
+auto parse_field(const char *first, const char *last, T &value) -> std::errc {
+    return detail::parse_field(first, last, last, value);
+}
+
+// Append every field of `text` to `out`; stops at the first bad field
+template <number T>
+auto parse(std::string_view text, std::vector<T> &out)
+    -> std::from_chars_result {
+    const char *p = text.data();
+    const char *last = p + text.size();
+    while (true) {
+        while (p != last && detail::is_delimiter(*p)) {
+            p++;
+        }
+        if (p == last) {
+            return {last, std::errc{}};
+        }
+        const char *end = detail::find_delimiter(p, last);
+        T value{};
+        if (auto ec = detail::parse_field(p, end, last, value);
+            ec != std::errc{}) {
+            return {p, ec};
+        }
+        out.push_back(value);
+        p = end;
+    }
+}
+
+template <number T> class StreamParser {
+  public:
+    // Parse every complete field in `chunk`; a field that runs to the end of
+    // the chunk is held back until the next `feed` (or `finish`)
+    auto feed(std::string_view chunk, std::vector<T> &out) -> std::errc {
+        if (!partial_.empty()) {
+            const char *first = chunk.data();
+            const char *end =
+                detail::find_delimiter(first, first + chunk.size());
+            auto n = static_cast<std::size_t>(end - first);
+            partial_.append(chunk.substr(0, n));
+            if (n == chunk.size()) {
+                return {};
+            }
+            if (auto ec = finish(out); ec != std::errc{}) {
+                return ec;
+            }
+            chunk.remove_prefix(n);
+        }
+        auto n = chunk.size();
+        while (n != 0 && !detail::is_delimiter(chunk[n - 1])) {
+            n--;
+        }
+        partial_.assign(chunk.substr(n));
+        return parse(chunk.substr(0, n), out).ec;
+    }
+
+    // Parse the held-back field, if any (call after the last chunk)
+    auto finish(std::vector<T> &out) -> std::errc {
+        auto ec = parse(std::string_view{partial_}, out).ec;
+        partial_.clear();
+        return ec;
+    }
+
+  private:
+    std::string partial_;
+};
+
+inline constexpr std::size_t read_chunk_size = std::size_t{1} << 20U;
+
+// Append every number in `file` to `out`
+template <number T>
+auto read(std::FILE *file, std::vector<T> &out) -> std::errc {
+    std::vector<char> buf(read_chunk_size);
+    StreamParser<T> parser;
+    while (true) {
+        auto n = std::fread(buf.data(), 1, buf.size(), file);
+        if (n == 0) {
+            return std::ferror(file) != 0 ? std::errc::io_error
+                                          : parser.finish(out);
+        }
+        if (auto ec = parser.feed({buf.data(), n}, out); ec != std::errc{}) {
+            return ec;
+        }
+    }
+}
+
+} // namespace number_parse
@@ -0,0 +1,85 @@
+#include <array>
+#include <charconv>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <print>
+#include <string_view>
+
+#include "bench/bench.hpp"
+#include "output/output.hpp"
+
+using namespace std;
+
+// Every method writes the same "var = <value>" lines to /dev/null, so only
+// formatting and the stream layer are measured (not the terminal)
+constexpr int num_lines = 2'000'000;
+constexpr int reps = 3;
+constexpr auto null_path = "/dev/null";
+
+auto main() -> int {
+    println("Output - buffered, batched sink vs per-line streaming\n");
+
+    std::FILE *null_file = std::fopen(null_path, "w");
+    std::ofstream null_stream{null_path};
+    if (null_file == nullptr || !null_stream) {
+        println("could not open {}", null_path);
+        return 1;
+    }
+
+    println("{} lines of `var = <int>` per run:", num_lines);
+
+    // std::cout with its buffer swapped for a /dev/null file buffer
+    // (still synced with stdio, like the `PRINT_VAR` in basic_concepts_i)
+    auto *cout_buf = std::cout.rdbuf(null_stream.rdbuf());
+    auto t = bench::time_best(reps, [] {
+        for (int var = 0; var < num_lines; var++) {
+            std::cout << "var" << " = " << var << "\n";
+        }
+        std::cout.flush();
+    });
+    std::cout.rdbuf(cout_buf);
+    bench::report("std::cout <<", t, num_lines, "lines");
+
+    t = bench::time_best(reps, [&] {
+        for (int var = 0; var < num_lines; var++) {
+            std::println(null_file, "{} = {}", "var", var);
+        }
+        std::fflush(null_file);
+    });
+    bench::report("std::println", t, num_lines, "lines");
+
+    // hand-formatted line, one fwrite per line
+    t = bench::time_best(reps, [&] {
+        std::array<char, 32> line{};
+        constexpr std::string_view prefix = "var = ";
+        std::ranges::copy(prefix, line.begin());
+        for (int var = 0; var < num_lines; var++) {
+            auto [end, _] = std::to_chars(line.data() + prefix.size(),
+                                          line.data() + line.size() - 1, var);
+            *end++ = '\n';
+            std::fwrite(line.data(), 1, static_cast<size_t>(end - line.data()),
+                        null_file);
+        }
+        std::fflush(null_file);
+    });
+    bench::report("to_chars + fwrite per line", t, num_lines, "lines");
+
+    t = bench::time_best(reps, [&] {
+        output::Sink sink{null_file};
+        for (int var = 0; var < num_lines; var++) {
+            sink.println("{} = {}", "var", var);
+        }
+        sink.flush();
+    });
+    bench::report("output::Sink", t, num_lines, "lines");
+
+    std::fclose(null_file);
+
+    println("\nBUFFERED_PRINT_VAR (thread-local sink on stdout):");
+    int answer = 42;
+    double ratio = 0.5;
+    BUFFERED_PRINT_VAR(answer)
+    BUFFERED_PRINT_VAR(ratio)
+    output::thread_sink().flush();
+}
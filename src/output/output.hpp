@@ -0,0 +1,150 @@
+#pragma once
+
+// Buffered, batched output
+//
+// `std::cout << ...` and `std::println(...)` each format and hand their text
+// to the C/C++ stream layer on every call (locking, locale and sync_with_stdio
+// work, and often a `write` syscall per line when stdout is a terminal or
+// pipe). When printing millions of values, that per-call cost dominates.
+//
+// `output::Sink` formats straight into its own append buffer and only hands
+// the buffer to `fwrite` when:
+//   - it is explicitly flushed (`flush()`)
+//   - the next write would not fit (size-triggered flush)
+//   - it is destroyed
+//
+// `output::thread_sink()` returns a thread-local sink on stdout, so threads
+// never contend on a lock until their batch is flushed; each flush is a
+// single `fwrite`, so batches from different threads don't interleave
+// mid-line.
+//
+// Text written through a sink is only ordered with respect to other writes to
+// the same `FILE *` (e.g. `std::println`) at flush points - call `flush()`
+// before mixing the two.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <format>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+namespace output {
+
+inline constexpr std::size_t default_capacity = std::size_t{64} * 1024;
+
+class Sink {
+  public:
+    // `capacity` is at least 1, so `put` always has room after a flush
+    explicit Sink(std::FILE *file = stdout,
+                  std::size_t capacity = default_capacity)
+        : file_{file},
+          data_{std::make_unique<char[]>(std::max<std::size_t>(capacity, 1))},
+          capacity_{std::max<std::size_t>(capacity, 1)} {}
+
+    Sink(const Sink &) = delete;
+    auto operator=(const Sink &) -> Sink & = delete;
+    Sink(Sink &&) = delete;
+    auto operator=(Sink &&) -> Sink & = delete;
+
+    ~Sink() { flush(); }
+
+    // Append `text` as-is
+    void write(std::string_view text) {
+        if (text.size() > capacity_ - size_) {
+            flush();
+            if (text.size() > capacity_) {
+                // bigger than the whole buffer - no point copying it first
+                std::fwrite(text.data(), 1, text.size(), file_);
+                return;
+            }
+        }
+        std::copy(text.begin(), text.end(), data_.get() + size_);
+        size_ += text.size();
+    }
+
+    void put(char c) {
+        if (size_ == capacity_) {
+            flush();
+        }
+        data_[size_++] = c;
+    }
+
+    // Format directly into the buffer
+    // - the common case formats exactly once, into the free tail
+    // - if the result doesn't fit, flush (and grow for oversized results) and
+    //   format again
+    template <typename... Args>
+    void print(std::format_string<Args...> fmt, Args &&...args) {
+        auto free = capacity_ - size_;
+        auto result = std::format_to_n(data_.get() + size_,
+                                       static_cast<std::ptrdiff_t>(free), fmt,
+                                       std::forward<Args>(args)...);
+        auto needed = static_cast<std::size_t>(result.size);
+        if (needed <= free) {
+            size_ += needed;
+            return;
+        }
+        flush();
+        if (needed > capacity_) {
+            data_ = std::make_unique<char[]>(needed);
+            capacity_ = needed;
+        }
+        std::format_to_n(data_.get(), static_cast<std::ptrdiff_t>(capacity_),
+                         fmt, std::forward<Args>(args)...);
+        size_ = needed;
+    }
+
+    template <typename... Args>
+    void println(std::format_string<Args...> fmt, Args &&...args) {
+        print(fmt, std::forward<Args>(args)...);
+        put('\n');
+    }
+
+    // Let `fill(char *first) -> char *last` write up to `max_size` chars
+    // straight into the buffer (for custom formatters, ex. `number_format`)
+    template <typename F> //
+    void append(std::size_t max_size, F &&fill) {
+        if (max_size > capacity_ - size_) {
+            flush();
+            if (max_size > capacity_) {
+                data_ = std::make_unique<char[]>(max_size);
+                capacity_ = max_size;
+            }
+        }
+        char *last = std::forward<F>(fill)(data_.get() + size_);
+        size_ = static_cast<std::size_t>(last - data_.get());
+    }
+
+    // Hand everything buffered so far to the `FILE *` and flush it through
+    void flush() {
+        if (size_ != 0) {
+            std::fwrite(data_.get(), 1, size_, file_);
+            size_ = 0;
+        }
+        std::fflush(file_);
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t { return size_; }
+    [[nodiscard]] auto capacity() const -> std::size_t { return capacity_; }
+
+  private:
+    std::FILE *file_;
+    std::unique_ptr<char[]> data_;
+    std::size_t size_ = 0;
+    std::size_t capacity_;
+};
+
+// Per-thread sink on stdout; flushed when the thread exits
+inline auto thread_sink() -> Sink & {
+    thread_local Sink sink{stdout};
+    return sink;
+}
+
+} // namespace output
+
+// Drop-in for the `PRINT_VAR` macros used by the other executables:
+//   #define PRINT_VAR(var) BUFFERED_PRINT_VAR(var)
+#define BUFFERED_PRINT_VAR(var)                                                \
+    output::thread_sink().println("{} = {}", #var, var);
@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <print>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "packed_record/packed_record.hpp"
+
+using namespace std;
+
+#define PRINT_VAR(var) std::println("{} = {}", #var, var);
+
+constexpr size_t num_records = 100'000'000;
+constexpr size_t batch = size_t{1} << 16U; // records per SoA batch
+constexpr int reps = 3;
+
+// The basic_concepts_iii bitfields
+struct S1 {
+    int b1 : 10;
+    int b2 : 10;
+    int b3 : 8;
+};
+struct S2 {
+    int b1 : 10;
+    int : 0;
+    int b2 : 10;
+};
+
+// The same layouts, explicit (and signed, as `int` bitfields are with gcc)
+constexpr auto sig = packed_record::Signedness::signed_;
+using P1 = packed_record::PackedRecord<uint32_t, packed_record::Field<10, sig>,
+                                       packed_record::Field<10, sig>,
+                                       packed_record::Field<8, sig>>;
+using P2 = packed_record::PackedRecord<uint64_t, packed_record::Field<10, sig>,
+                                       packed_record::Skip<22>,
+                                       packed_record::Field<10, sig>>;
+enum S1Field : uint8_t { b1, b2, b3 };
+
+auto main() -> int {
+    println("Packed record - explicit bit layouts, SIMD unpack to SoA");
+
+    println("\nbasic_concepts_iii layouts:");
+    auto sizeof_S1 = sizeof(S1);
+    auto sizeof_P1 = sizeof(P1);
+    auto sizeof_S2 = sizeof(S2);
+    auto sizeof_P2 = sizeof(P2);
+    PRINT_VAR(sizeof_S1)
+    PRINT_VAR(sizeof_P1)
+    PRINT_VAR(sizeof_S2)
+    PRINT_VAR(sizeof_P2)
+    // "range [0, 1023]" only holds for an unsigned field
+    auto p = P1::make(1023, -5, 100);
+    PRINT_VAR(p.get<b1>())
+    PRINT_VAR(p.get<b2>())
+    using U1 = packed_record::PackedRecord<uint32_t, packed_record::Field<10>>;
+    PRINT_VAR(U1::make(1023).get<0>())
+    println("wire word = {:#010x} (same bytes on every host)", p.word());
+
+    println("\n{} records of 3 fields (10 + 10 + 8 bits):", num_records);
+    mt19937_64 rng{14};
+    vector<S1> native(num_records);
+    vector<P1> packed(num_records);
+    for (size_t i = 0; i < num_records; i++) {
+        auto r = rng();
+        auto f1 = static_cast<int>(r % 1024) - 512;
+        auto f2 = static_cast<int>((r >> 10U) % 1024) - 512;
+        auto f3 = static_cast<int>((r >> 20U) % 256) - 128;
+        packed[i] = P1::make(f1, f2, f3);
+        // x86-64 gcc happens to lay S1 out the same way (from bit 0 up); the
+        // sums below check it
+        std::memcpy(&native[i], &packed[i], sizeof(S1));
+    }
+
+    // one field of every record
+    int64_t native_sum = 0;
+    auto t = bench::time_best(reps, [&] {
+        native_sum = 0;
+        for (const auto &s : native) {
+            native_sum += s.b2;
+        }
+    });
+    bench::report("native bitfield, one field", t, num_records, "records");
+    int64_t packed_sum = 0;
+    t = bench::time_best(reps, [&] {
+        packed_sum = 0;
+        for (const auto &s : packed) {
+            packed_sum += s.get<b2>();
+        }
+    });
+    bench::report("PackedRecord::get, one field", t, num_records, "records");
+    println("  sums match: {}", native_sum == packed_sum);
+
+    // all fields into SoA columns, one cache-sized batch at a time
+    vector<int32_t> c1(batch);
+    vector<int32_t> c2(batch);
+    vector<int32_t> c3(batch);
+    auto consume = [&](size_t n) {
+        int64_t sum = 0;
+        for (size_t j = 0; j < n; j++) {
+            sum += c1[j] + c2[j] + c3[j];
+        }
+        return sum;
+    };
+    t = bench::time_best(reps, [&] {
+        native_sum = 0;
+        for (size_t i = 0; i < num_records; i += batch) {
+            auto n = min(batch, num_records - i);
+            for (size_t j = 0; j < n; j++) {
+                const auto &s = native[i + j];
+                c1[j] = s.b1;
+                c2[j] = s.b2;
+                c3[j] = s.b3;
+            }
+            native_sum += consume(n);
+        }
+    });
+    bench::report("native bitfields -> SoA", t, num_records, "records");
+    t = bench::time_best(reps, [&] {
+        packed_sum = 0;
+        for (size_t i = 0; i < num_records; i += batch) {
+            auto n = min(batch, num_records - i);
+            P1::unpack(span<const P1>{packed}.subspan(i, n), span{c1},
+                       span{c2}, span{c3});
+            packed_sum += consume(n);
+        }
+    });
+    bench::report("PackedRecord::unpack -> SoA", t, num_records, "records");
+    println("  sums match: {}", native_sum == packed_sum);
+}
@@ -0,0 +1,220 @@
+#pragma once
+
+// Packed records with an explicit bit layout
+//
+// C++ bitfields (`int b1 : 10;`) leave the layout to the implementation:
+// bit order within the word, whether a field may straddle a storage unit,
+// and the signedness of plain `int` fields all vary between ABIs, so the
+// bytes can't be shared between programs. They are also read one field at a
+// time through scalar shift/mask code.
+//
+// `PackedRecord<Word, Fields...>` lays its fields out explicitly:
+//   - fields are packed from bit 0 of `Word` upwards, in declaration order
+//   - `Field<Bits, Signedness>` is a named field; `Skip<Bits>` is padding
+//     (`int : 0` in a bitfield becomes a `Skip` up to the next word boundary
+//     inside a wider `Word`)
+//   - the word is stored little-endian, so an array of records *is* the
+//     wire format on every host (`sizeof(record) == sizeof(Word)`)
+//   - `set` stores the low `Bits` bits of the value (like assigning to a
+//     bitfield); `get` zero- or sign-extends them
+//
+// Fields are addressed by their index among the named fields (an enum of
+// field names works well). `unpack` converts a whole array of records into
+// one column per field (SoA) with `std::experimental::simd`: each register
+// of records is loaded once, and every field is one shift and one mask (or
+// a shift pair for sign extension) away.
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <experimental/simd>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace packed_record {
+
+namespace stdx = std::experimental;
+
+enum class Signedness : std::uint8_t { unsigned_, signed_ };
+
+template <unsigned Bits, Signedness S = Signedness::unsigned_> struct Field {
+    static constexpr unsigned bits = Bits;
+    static constexpr bool is_signed = S == Signedness::signed_;
+    static constexpr bool named = true;
+};
+
+template <unsigned Bits> struct Skip {
+    static constexpr unsigned bits = Bits;
+    static constexpr bool is_signed = false;
+    static constexpr bool named = false;
+};
+
+template <typename W>
+concept word = std::same_as<W, std::uint8_t> ||
+               std::same_as<W, std::uint16_t> ||
+               std::same_as<W, std::uint32_t> || std::same_as<W, std::uint64_t>;
+
+namespace detail {
+
+struct FieldLayout {
+    unsigned shift;
+    unsigned bits;
+    bool is_signed;
+};
+
+template <typename... Fields>
+constexpr auto named_layout()
+    -> std::array<FieldLayout, (std::size_t{Fields::named} + ... + 0)> {
+    std::array<FieldLayout, (std::size_t{Fields::named} + ... + 0)> layout{};
+    unsigned shift = 0;
+    std::size_t i = 0;
+    auto add = [&](unsigned bits, bool is_signed, bool named) {
+        if (named) {
+            layout[i++] = {shift, bits, is_signed};
+        }
+        shift += bits;
+    };
+    (add(Fields::bits, Fields::is_signed, Fields::named), ...);
+    return layout;
+}
+
+template <word Word> constexpr auto to_little(Word w) -> Word {
+    if constexpr (std::endian::native == std::endian::big) {
+        return std::byteswap(w);
+    } else {
+        return w;
+    }
+}
+
+} // namespace detail
+
+template <word Word, typename... Fields> class PackedRecord {
+  public:
+    using word_type = Word;
+
+    static constexpr auto layout = detail::named_layout<Fields...>();
+    static constexpr std::size_t num_fields = layout.size();
+
+    static_assert((Fields::bits + ... + 0) <=
+                      std::numeric_limits<Word>::digits,
+                  "fields don't fit in the word");
+    static_assert(((Fields::bits > 0) && ...), "zero-width field");
+
+    // Value type of field `I`: the (signed) word type
+    template <std::size_t I>
+    using value_type = std::conditional_t<layout[I].is_signed,
+                                          std::make_signed_t<Word>, Word>;
+
+    constexpr PackedRecord() = default;
+
+    // A record from one value per named field
+    template <typename... Values>
+        requires(sizeof...(Values) == num_fields)
+    static constexpr auto make(Values... values) -> PackedRecord {
+        PackedRecord record;
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (record.template set<I>(static_cast<value_type<I>>(values)), ...);
+        }(std::make_index_sequence<num_fields>{});
+        return record;
+    }
+
+    template <std::size_t I>
+    [[nodiscard]] constexpr auto get() const -> value_type<I> {
+        return extract<I>(word());
+    }
+
+    template <std::size_t I> constexpr void set(value_type<I> value) {
+        constexpr auto mask = field_mask<I>() << layout[I].shift;
+        auto bits = static_cast<Word>(static_cast<Word>(value)
+                                      << layout[I].shift);
+        set_word(static_cast<Word>((word() & ~mask) | (bits & mask)));
+    }
+
+    // The record as a native-endian word
+    [[nodiscard]] constexpr auto word() const -> Word {
+        return detail::to_little(wire_);
+    }
+    constexpr void set_word(Word w) { wire_ = detail::to_little(w); }
+
+    // Field `I` of a native-endian record word
+    template <std::size_t I>
+    static constexpr auto extract(Word w) -> value_type<I> {
+        constexpr unsigned width = std::numeric_limits<Word>::digits;
+        if constexpr (layout[I].is_signed) {
+            // move the field's top bit to the word's sign bit, then shift
+            // back arithmetically
+            using S = std::make_signed_t<Word>;
+            constexpr unsigned up = width - layout[I].shift - layout[I].bits;
+            return static_cast<S>(static_cast<S>(w << up) >>
+                                  (width - layout[I].bits));
+        } else {
+            return static_cast<Word>((w >> layout[I].shift) &
+                                     field_mask<I>());
+        }
+    }
+
+    // One column per named field: `columns[I][r] = records[r].get<I>()`
+    template <typename... Columns>
+        requires(sizeof...(Columns) == num_fields)
+    static void unpack(std::span<const PackedRecord> records,
+                       Columns... columns) {
+        unpack_impl(records, std::make_index_sequence<num_fields>{},
+                    columns...);
+    }
+
+  private:
+    template <std::size_t I> static constexpr auto field_mask() -> Word {
+        return static_cast<Word>(std::numeric_limits<Word>::max() >>
+                                 (std::numeric_limits<Word>::digits -
+                                  layout[I].bits));
+    }
+
+    using word_simd = stdx::native_simd<Word>;
+    using signed_simd =
+        stdx::rebind_simd_t<std::make_signed_t<Word>, word_simd>;
+
+    template <std::size_t I>
+    static auto extract_simd(const word_simd &w)
+        -> stdx::rebind_simd_t<value_type<I>, word_simd> {
+        constexpr int width = std::numeric_limits<Word>::digits;
+        constexpr auto shift = static_cast<int>(layout[I].shift);
+        constexpr auto bits = static_cast<int>(layout[I].bits);
+        if constexpr (layout[I].is_signed) {
+            auto up = w << (width - shift - bits);
+            return stdx::static_simd_cast<signed_simd>(up) >> (width - bits);
+        } else {
+            return (w >> shift) & word_simd{field_mask<I>()};
+        }
+    }
+
+    template <std::size_t... I, typename... Columns>
+    static void unpack_impl(std::span<const PackedRecord> records,
+                            std::index_sequence<I...>, Columns... columns) {
+        static_assert(sizeof(PackedRecord) == sizeof(Word));
+        constexpr std::size_t lanes = word_simd::size();
+        std::size_t r = 0;
+        if constexpr (std::endian::native == std::endian::little) {
+            // a record array is an array of little-endian words
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            const auto *words = reinterpret_cast<const Word *>(records.data());
+            for (; r + lanes <= records.size(); r += lanes) {
+                word_simd w{words + r, stdx::element_aligned};
+                (extract_simd<I>(w).copy_to(columns.data() + r,
+                                            stdx::element_aligned),
+                 ...);
+            }
+        }
+        for (; r < records.size(); r++) {
+            auto w = records[r].word();
+            ((columns[r] = extract<I>(w)), ...);
+        }
+    }
+
+    Word wire_ = 0;
+};
+
+} // namespace packed_record
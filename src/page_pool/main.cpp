@@ -0,0 +1,176 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <print>
+#include <random>
+#include <span>
+#include <string>
+#include <utility>
+
+#include "bench/bench.hpp"
+#include "page_pool/page_pool.hpp"
+
+using namespace std;
+
+#define PRINT_VAR(var) std::println("{} = {}", #var, var);
+
+constexpr size_t touch_bytes = size_t{512} << 20;
+constexpr size_t chase_bytes = size_t{1} << 30;
+constexpr size_t chase_steps = 4'000'000;
+constexpr size_t line = 64;
+constexpr int reps = 3;
+
+using page_pool::PagePool;
+
+// Transparent huge pages backing this process, from /proc (0 elsewhere)
+auto anon_huge_kib() -> size_t {
+    ifstream smaps{"/proc/self/smaps_rollup"};
+    string key;
+    size_t kib = 0;
+    while (smaps >> key) {
+        if (key == "AnonHugePages:") {
+            smaps >> kib;
+            return kib;
+        }
+    }
+    return 0;
+}
+
+// One write per 4 KiB page: the cost is almost all page faults
+void touch(span<byte> buffer) {
+    for (size_t i = 0; i < buffer.size(); i += 4096) {
+        buffer[i] = byte{1};
+    }
+    bench::clobber_memory();
+}
+
+// `allocate() -> span<byte>` and `release(span<byte>)`
+template <typename Allocate, typename Release>
+void bench_first_touch(const char *label, Allocate allocate,
+                       Release release) {
+    auto pages = static_cast<double>(touch_bytes / 4096);
+    span<byte> buffer;
+    auto t = bench::time_best(
+        reps,
+        [&] {
+            if (!buffer.empty()) {
+                release(buffer);
+            }
+            buffer = allocate();
+        },
+        [&] { touch(buffer); });
+    release(buffer);
+    bench::report(string{label} + ": first pass", t, pages, "pages");
+    t = bench::time_best(reps, [&] {
+        auto fresh = allocate();
+        touch(fresh);
+        release(fresh);
+    });
+    bench::report(string{label} + ": alloc+touch+free", t, pages, "pages");
+}
+
+// A random cycle through every cache line of `buffer` (Sattolo's shuffle),
+// each line holding the index of the next
+void build_chain(span<byte> buffer) {
+    auto lines = buffer.size() / line;
+    auto next = [&](size_t i) {
+        return reinterpret_cast<uint32_t *>(buffer.data() + (i * line));
+    };
+    for (size_t i = 0; i < lines; i++) {
+        *next(i) = static_cast<uint32_t>(i);
+    }
+    mt19937_64 rng{24};
+    for (size_t i = lines - 1; i > 0; i--) {
+        auto j = static_cast<size_t>(rng() % i);
+        swap(*next(i), *next(j));
+    }
+}
+
+// Dependent loads: each one's address comes from the previous one, so the
+// time per step is the full latency, TLB miss included
+auto chase(span<const byte> buffer) -> uint32_t {
+    uint32_t i = 0;
+    for (size_t step = 0; step < chase_steps; step++) {
+        i = *reinterpret_cast<const uint32_t *>(buffer.data() + (i * line));
+    }
+    return i;
+}
+
+void bench_chase(const char *label, span<byte> buffer) {
+    build_chain(buffer);
+    uint32_t end = 0;
+    auto t = bench::time_best(reps, [&] { end = chase(buffer); });
+    bench::do_not_optimize(end);
+    bench::report(label, t, static_cast<double>(chase_steps), "accesses");
+    println("    {:.1f} ns per access",
+            t * 1e9 / static_cast<double>(chase_steps));
+}
+
+auto main() -> int {
+    println("Page pool - mmap, transparent huge pages, prefaulting");
+
+    // basic_concepts_iv: "OS provides memory in pages"
+    auto page_size = page_pool::page_size();
+    PRINT_VAR(page_size)
+    PRINT_VAR(page_pool::huge_page_size)
+    {
+        PagePool small{size_t{1} << 20, {.huge_pages = false}};
+        auto a = small.allocate(10); // a whole page for 10 bytes
+        auto b = small.allocate(3 * page_size);
+        PRINT_VAR(a.size())
+        PRINT_VAR(small.bytes_free())
+        small.deallocate(a);
+        small.deallocate(b); // coalesces back into one free range
+        PRINT_VAR(small.bytes_free())
+    }
+    {
+        PagePool huge{size_t{64} << 20, {.huge_pages = true, .populate = true}};
+        PRINT_VAR(huge.huge_pages())
+        PRINT_VAR(huge.granule())
+        auto thp_kib = anon_huge_kib();
+        PRINT_VAR(thp_kib)
+    }
+
+    println("\nfirst touch of {} MiB (one write per 4 KiB page):",
+            touch_bytes >> 20);
+    bench_first_touch(
+        "malloc",
+        [] {
+            return span{static_cast<byte *>(malloc(touch_bytes)),
+                        touch_bytes};
+        },
+        [](span<byte> buffer) { free(buffer.data()); });
+    PagePool small_pages{touch_bytes, {.huge_pages = false}};
+    bench_first_touch(
+        "4 KiB pages",
+        [&] { return small_pages.allocate(touch_bytes); },
+        [&](span<byte> buffer) { small_pages.deallocate(buffer); });
+    PagePool huge_pages{touch_bytes};
+    bench_first_touch(
+        "huge pages",
+        [&] { return huge_pages.allocate(touch_bytes); },
+        [&](span<byte> buffer) { huge_pages.deallocate(buffer); });
+    PagePool populated{touch_bytes, {.huge_pages = true, .populate = true}};
+    bench_first_touch(
+        "huge pages, populated",
+        [&] { return populated.allocate(touch_bytes); },
+        [&](span<byte> buffer) { populated.deallocate(buffer); });
+
+    println("\nrandom access, pointer chase over {} MiB:", chase_bytes >> 20);
+    {
+        span buffer{static_cast<byte *>(malloc(chase_bytes)), chase_bytes};
+        bench_chase("malloc", buffer);
+        free(buffer.data());
+    }
+    {
+        PagePool pool{chase_bytes, {.huge_pages = false}};
+        bench_chase("4 KiB pages", pool.allocate(chase_bytes));
+    }
+    {
+        PagePool pool{chase_bytes};
+        auto buffer = pool.allocate(chase_bytes);
+        bench_chase("huge pages", buffer);
+        println("    {} MiB in transparent huge pages", anon_huge_kib() >> 10);
+    }
+}
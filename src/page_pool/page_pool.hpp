@@ -0,0 +1,203 @@
+#pragma once
+
+// Page-granular memory pool over one `mmap`ed range
+//
+// basic_concepts_iv: the OS hands out memory in (4096-byte) pages. Each page
+// is mapped on first touch (a page fault) and needs a TLB entry, so a large
+// buffer pays a fault storm when first written and TLB misses when read at
+// random. `PagePool` manages pages directly:
+//   - reserves `capacity` bytes of address space with one `mmap`, aligned to
+//     a huge page; memory is only committed when touched
+//   - `huge_pages`: `madvise(MADV_HUGEPAGE)` asks for transparent huge pages
+//     (2 MiB on x86-64: one fault and one TLB entry per 512 small pages);
+//     allocations are then rounded up to whole huge pages
+//   - `populate`: prefaults the reservation up front (`MAP_POPULATE`, or
+//     after `MADV_HUGEPAGE` so the faults map huge pages) and each
+//     allocation again (`MADV_POPULATE_WRITE`), moving fault cost out of
+//     the first pass over the data
+//   - `deallocate` returns the pages' memory to the OS (`MADV_DONTNEED`) but
+//     keeps the address range; the next `allocate` of it gets zeroed pages
+//
+// Free ranges are kept sorted and coalesced; allocation is first fit. Huge
+// pages and prefaulting are Linux features and are skipped elsewhere (or
+// when THP is disabled: `/sys/kernel/mm/transparent_hugepage/enabled`).
+// Not thread-safe.
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace page_pool {
+
+inline constexpr std::size_t huge_page_size = std::size_t{2} << 20;
+
+inline auto page_size() -> std::size_t {
+    static const auto size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+struct Options {
+    bool huge_pages = true;
+    bool populate = false;
+};
+
+class PagePool {
+  public:
+    explicit PagePool(std::size_t capacity, Options options = {})
+        : options_{options},
+          granule_{options.huge_pages ? huge_page_size : page_size()},
+          capacity_{round_up(capacity, granule_)} {
+        if (capacity_ == 0) {
+            throw std::invalid_argument{"page_pool: zero capacity"};
+        }
+        // reserve one extra huge page to align the start
+        auto reserved = capacity_ + huge_page_size;
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+        flags |= MAP_NORESERVE;
+#endif
+#ifdef MAP_POPULATE
+        if (options_.populate && !options_.huge_pages) {
+            flags |= MAP_POPULATE;
+        }
+#endif
+        void *mapping =
+            mmap(nullptr, reserved, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (mapping == MAP_FAILED) {
+            throw std::system_error{errno, std::generic_category(),
+                                    "page_pool: mmap"};
+        }
+        auto *raw = static_cast<std::byte *>(mapping);
+        auto address = reinterpret_cast<std::uintptr_t>(raw);
+        auto skip = round_up(address, huge_page_size) - address;
+        if (skip != 0) {
+            munmap(raw, skip);
+        }
+        munmap(raw + skip + capacity_, huge_page_size - skip);
+        base_ = raw + skip;
+
+#ifdef MADV_HUGEPAGE
+        if (options_.huge_pages) {
+            huge_pages_ = madvise(base_, capacity_, MADV_HUGEPAGE) == 0;
+        }
+#endif
+        if (options_.populate && options_.huge_pages) {
+            prefault(base_, capacity_);
+        }
+        free_.emplace(0, capacity_);
+        free_bytes_ = capacity_;
+    }
+
+    PagePool(const PagePool &) = delete;
+    auto operator=(const PagePool &) -> PagePool & = delete;
+    PagePool(PagePool &&) = delete;
+    auto operator=(PagePool &&) -> PagePool & = delete;
+
+    ~PagePool() { munmap(base_, capacity_); }
+
+    // At least `bytes` of zeroed pages, rounded up to `granule()`; throws
+    // `std::bad_alloc` if no free range is large enough
+    [[nodiscard]] auto allocate(std::size_t bytes) -> std::span<std::byte> {
+        auto size = round_up(std::max<std::size_t>(bytes, 1), granule_);
+        for (auto it = free_.begin(); it != free_.end(); ++it) {
+            auto [offset, length] = *it;
+            if (length < size) {
+                continue;
+            }
+            free_.erase(it);
+            if (length > size) {
+                free_.emplace(offset + size, length - size);
+            }
+            free_bytes_ -= size;
+            std::span<std::byte> pages{base_ + offset, size};
+            if (options_.populate) {
+                prefault(pages.data(), pages.size());
+            }
+            return pages;
+        }
+        throw std::bad_alloc{};
+    }
+
+    // `pages` must be exactly what `allocate` returned
+    void deallocate(std::span<std::byte> pages) {
+        auto address = reinterpret_cast<std::uintptr_t>(pages.data());
+        auto start = reinterpret_cast<std::uintptr_t>(base_);
+        if (pages.empty() || address < start ||
+            address - start + pages.size() > capacity_ ||
+            (address - start) % granule_ != 0 ||
+            pages.size() % granule_ != 0) {
+            throw std::invalid_argument{"page_pool: not from this pool"};
+        }
+        // any overlap with a free range (which may have been coalesced since
+        // `pages` were freed) is a double deallocate
+        auto offset = address - start;
+        auto after = free_.lower_bound(offset);
+        if ((after != free_.end() && offset + pages.size() > after->first) ||
+            (after != free_.begin() &&
+             std::prev(after)->first + std::prev(after)->second > offset)) {
+            throw std::invalid_argument{"page_pool: double deallocate"};
+        }
+        auto it = free_.emplace_hint(after, offset, pages.size());
+        madvise(pages.data(), pages.size(), MADV_DONTNEED);
+        free_bytes_ += pages.size();
+        if (auto next = std::next(it);
+            next != free_.end() && it->first + it->second == next->first) {
+            it->second += next->second;
+            free_.erase(next);
+        }
+        if (it != free_.begin()) {
+            if (auto prev = std::prev(it);
+                prev->first + prev->second == it->first) {
+                prev->second += it->second;
+                free_.erase(it);
+            }
+        }
+    }
+
+    // Allocation size unit: a huge page with `huge_pages`, else a page
+    [[nodiscard]] auto granule() const -> std::size_t { return granule_; }
+    [[nodiscard]] auto capacity() const -> std::size_t { return capacity_; }
+    [[nodiscard]] auto bytes_free() const -> std::size_t {
+        return free_bytes_;
+    }
+    // Whether the kernel accepted `MADV_HUGEPAGE`
+    [[nodiscard]] auto huge_pages() const -> bool { return huge_pages_; }
+
+  private:
+    static auto round_up(std::size_t n, std::size_t unit) -> std::size_t {
+        return (n + unit - 1) / unit * unit;
+    }
+
+    // Fault every page in now; writes one byte per page if the kernel has no
+    // `MADV_POPULATE_WRITE` (before Linux 5.14)
+    static void prefault(std::byte *data, std::size_t size) {
+#ifdef MADV_POPULATE_WRITE
+        if (madvise(data, size, MADV_POPULATE_WRITE) == 0) {
+            return;
+        }
+#endif
+        for (std::size_t i = 0; i < size; i += page_size()) {
+            *static_cast<volatile std::byte *>(data + i) = std::byte{0};
+        }
+    }
+
+    Options options_;
+    std::size_t granule_;
+    std::size_t capacity_;
+    std::byte *base_ = nullptr;
+    bool huge_pages_ = false;
+    std::map<std::size_t, std::size_t> free_; // offset -> length
+    std::size_t free_bytes_ = 0;
+};
+
+} // namespace page_pool
@@ -0,0 +1,60 @@
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <print>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "parallel_reduce/parallel_reduce.hpp"
+
+using namespace std;
+
+constexpr size_t num_values = 32'000'000;
+constexpr int reps = 5;
+
+auto main() -> int {
+    println("Parallel Reduce - deterministic multithreaded float sums");
+
+    mt19937 rng{6};
+    uniform_real_distribution<float> dist{0.0F, 1.0F};
+    vector<float> data(num_values);
+    for (auto &v : data) {
+        v = dist(rng);
+    }
+    span<const float> values{data};
+
+    auto max_threads = max(1U, std::thread::hardware_concurrency());
+    println("{} floats, 1 to {} threads\n", num_values, max_threads);
+
+    // powers of two, plus all cores
+    vector<unsigned> thread_counts;
+    for (unsigned threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    double single_thread = 0;
+    uint32_t reference_bits = 0;
+    bool identical = true;
+    for (auto threads : thread_counts) {
+        parallel_reduce::ThreadPool pool{threads};
+        float result = 0;
+        auto t = bench::time_best(reps, [&] {
+            result = parallel_reduce::sum(pool, values);
+            bench::do_not_optimize(result);
+        });
+        auto bits = std::bit_cast<uint32_t>(result);
+        if (threads == 1) {
+            single_thread = t;
+            reference_bits = bits;
+        }
+        identical = identical && bits == reference_bits;
+        println("  {:>3} threads: {:>8.2f} ms  {:>5.2f}x  result {} ({:#010x})",
+                threads, t * 1e3, single_thread / t, result, bits);
+    }
+    println("\nbit-identical across thread counts: {}", identical);
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+// Deterministic multithreaded reduction
+//
+// Floating-point addition isn't associative, so the usual "one partial per
+// thread, then add the partials" changes the result whenever the thread
+// count changes. Here the shape of the computation never depends on the
+// threads:
+//   1. the input is cut into fixed-size chunks (`chunk_size` elements,
+//      regardless of how many threads there are)
+//   2. each chunk is reduced by `leaf` into its own slot - threads only
+//      decide *when* a chunk is reduced, not *how*
+//   3. the slots are combined in a fixed balanced binary tree
+// so the result is bit-identical for 1 thread or 64.
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "parallel_reduce/thread_pool.hpp"
+#include "summation/summation.hpp"
+
+namespace parallel_reduce {
+
+inline constexpr std::size_t default_chunk_size = std::size_t{1} << 16;
+
+namespace detail {
+
+// Combine partials[lo, hi) in a balanced tree that depends only on the range
+template <typename R, typename Combine>
+auto tree(std::span<const R> partials, Combine &combine) -> R {
+    if (partials.size() == 1) {
+        return partials[0];
+    }
+    auto half = partials.size() / 2;
+    return combine(tree(partials.first(half), combine),
+                   tree(partials.subspan(half), combine));
+}
+
+} // namespace detail
+
+// `leaf(span<const T>) -> R` reduces one chunk; `combine(R, R) -> R` merges
+// two partial results; `identity` is returned for empty input
+template <typename T, typename R, typename Leaf, typename Combine>
+auto reduce(ThreadPool &pool, std::span<const T> values, R identity,
+            Leaf leaf, Combine combine,
+            std::size_t chunk_size = default_chunk_size) -> R {
+    if (values.empty()) {
+        return identity;
+    }
+    auto num_chunks = (values.size() + chunk_size - 1) / chunk_size;
+    std::vector<R> partials(num_chunks, identity);
+    pool.for_each_index(num_chunks, [&](std::size_t c) {
+        auto first = c * chunk_size;
+        auto count = std::min(chunk_size, values.size() - first);
+        partials[c] = leaf(values.subspan(first, count));
+    });
+    return detail::tree(std::span<const R>{partials}, combine);
+}
+
+// Sum with pairwise chunks (see summation/summation.hpp)
+template <std::floating_point T>
+auto sum(ThreadPool &pool, std::span<const T> values,
+         std::size_t chunk_size = default_chunk_size) -> T {
+    return reduce(
+        pool, values, T{0}, summation::pairwise<T>,
+        [](T a, T b) { return a + b; }, chunk_size);
+}
+
+} // namespace parallel_reduce
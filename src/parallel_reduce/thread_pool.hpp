@@ -0,0 +1,107 @@
+#pragma once
+
+// Minimal fork-join thread pool
+//
+// `for_each_index(count, fn)` calls `fn(i)` once for every `i` in
+// [0, count), spread over the worker threads and the calling thread, and
+// returns when all calls have finished. Indices are handed out dynamically
+// (one atomic counter), so which thread runs which index varies run to run -
+// anything that must be deterministic has to depend only on `i`.
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace parallel_reduce {
+
+class ThreadPool {
+  public:
+    // `num_threads` includes the calling thread
+    explicit ThreadPool(
+        std::size_t num_threads = std::thread::hardware_concurrency()) {
+        for (std::size_t t = 1; t < num_threads; t++) {
+            workers_.emplace_back([this] { work(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    auto operator=(const ThreadPool &) -> ThreadPool & = delete;
+    ThreadPool(ThreadPool &&) = delete;
+    auto operator=(ThreadPool &&) -> ThreadPool & = delete;
+
+    ~ThreadPool() {
+        {
+            std::scoped_lock lock{mutex_};
+            stop_ = true;
+        }
+        wake_.notify_all();
+        workers_.clear(); // join before the members they use are destroyed
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t {
+        return workers_.size() + 1;
+    }
+
+    template <typename F> //
+    void for_each_index(std::size_t count, F &&fn) {
+        {
+            std::scoped_lock lock{mutex_};
+            job_ = std::forward<F>(fn);
+            count_ = count;
+            next_ = 0;
+            busy_ = workers_.size();
+            generation_++;
+        }
+        wake_.notify_all();
+        run_job();
+        std::unique_lock lock{mutex_};
+        done_.wait(lock, [this] { return busy_ == 0; });
+        job_ = nullptr;
+    }
+
+  private:
+    void run_job() {
+        for (auto i = next_.fetch_add(1); i < count_; i = next_.fetch_add(1)) {
+            job_(i);
+        }
+    }
+
+    void work() {
+        std::uint64_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock lock{mutex_};
+                wake_.wait(lock,
+                           [&] { return stop_ || generation_ != seen; });
+                if (stop_) {
+                    return;
+                }
+                seen = generation_;
+            }
+            run_job();
+            {
+                std::scoped_lock lock{mutex_};
+                busy_--;
+            }
+            done_.notify_one();
+        }
+    }
+
+    std::vector<std::jthread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::function<void(std::size_t)> job_;
+    std::atomic<std::size_t> next_ = 0;
+    std::size_t count_ = 0;
+    std::size_t busy_ = 0;
+    std::uint64_t generation_ = 0;
+    bool stop_ = false;
+};
+
+} // namespace parallel_reduce
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <print>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "quadratic/quadratic.hpp"
+
+using namespace std;
+
+#define PRINT_VAR(var) std::println("{} = {}", #var, var);
+
+constexpr size_t num_equations = 4'000'000;
+constexpr int reps = 5;
+
+// Relative error of the small-magnitude root (the one cancellation destroys)
+// against a long double reference, over the equations with real roots
+struct Accuracy {
+    double max_rel = 0;
+    double mean_rel = 0;
+};
+
+template <typename T>
+auto small_root_accuracy(span<const float> a, span<const float> b,
+                         span<const float> c, span<const T> small)
+    -> Accuracy {
+    Accuracy acc;
+    size_t count = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        auto ref = quadratic::solve_one<long double>(a[i], b[i], c[i]);
+        if (ref.kind != quadratic::Roots::real) {
+            continue;
+        }
+        auto exact = abs(ref.x1) < abs(ref.x2) ? ref.x1 : ref.x2;
+        auto rel = static_cast<double>(abs((small[i] - exact) / exact));
+        acc.max_rel = max(acc.max_rel, rel);
+        acc.mean_rel += rel;
+        count++;
+    }
+    acc.mean_rel /= static_cast<double>(max(count, size_t{1}));
+    return acc;
+}
+
+template <typename T>
+void report(const char *name, double t, const Accuracy &acc) {
+    bench::report(name, t, num_equations, "eqs");
+    println("  {:<36} small root rel error: max {:.3g}, mean {:.3g}", "",
+            acc.max_rel, acc.mean_rel);
+}
+
+auto main() -> int {
+    println("Quadratic - batched, numerically stable solver");
+
+    println("\nthe basic_concepts_ii case: x^2 + 5000x + 0.25 = 0");
+    auto res_float =
+        (-5000 + std::sqrt((5000.0F * 5000.0F) - (4.0F * 1.0F * 0.25F))) / 2;
+    PRINT_VAR(res_float)
+    auto res_double =
+        (-5000 + std::sqrt((5000.0 * 5000.0) - (4.0 * 1.0 * 0.25))) / 2;
+    PRINT_VAR(res_double)
+    auto res_stable = quadratic::solve_one(1.0F, 5000.0F, 0.25F).x2;
+    PRINT_VAR(res_stable)
+
+    // real roots with |b| >> |ac|, mostly
+    mt19937 rng{8};
+    uniform_real_distribution<float> da{0.5F, 2.0F};
+    uniform_real_distribution<float> db{1.0F, 10'000.0F};
+    uniform_real_distribution<float> dc{0.01F, 1.0F};
+    vector<float> a(num_equations);
+    vector<float> b(num_equations);
+    vector<float> c(num_equations);
+    for (size_t i = 0; i < num_equations; i++) {
+        a[i] = da(rng);
+        b[i] = (i % 2 == 0 ? 1.0F : -1.0F) * db(rng);
+        c[i] = dc(rng);
+    }
+    println("\n{} equations, |b| in [1, 10'000], a in [0.5, 2], c in "
+            "[0.01, 1]:",
+            num_equations);
+
+    // naive form, small root = (-b + sign(b) sqrt(disc)) / 2a
+    vector<float> small_f(num_equations);
+    auto t = bench::time_best(reps, [&] {
+        for (size_t i = 0; i < num_equations; i++) {
+            float root = std::sqrt((b[i] * b[i]) - (4.0F * a[i] * c[i]));
+            small_f[i] = (-b[i] + std::copysign(root, b[i])) / (2.0F * a[i]);
+        }
+        bench::do_not_optimize(small_f.data());
+    });
+    report<float>("naive float", t,
+                  small_root_accuracy<float>(a, b, c, small_f));
+
+    vector<double> small_d(num_equations);
+    t = bench::time_best(reps, [&] {
+        for (size_t i = 0; i < num_equations; i++) {
+            double ai = a[i];
+            double bi = b[i];
+            double root = std::sqrt((bi * bi) - (4.0 * ai * c[i]));
+            small_d[i] = (-bi + std::copysign(root, bi)) / (2.0 * ai);
+        }
+        bench::do_not_optimize(small_d.data());
+    });
+    report<double>("naive double", t,
+                   small_root_accuracy<double>(a, b, c, small_d));
+
+    vector<float> x1(num_equations);
+    vector<float> x2(num_equations);
+    vector<quadratic::Roots> kind(num_equations);
+    t = bench::time_best(reps, [&] {
+        quadratic::solve<float>(a, b, c, x1, x2, kind);
+        bench::do_not_optimize(x1.data());
+        bench::do_not_optimize(x2.data());
+    });
+    for (size_t i = 0; i < num_equations; i++) {
+        small_f[i] = abs(x1[i]) < abs(x2[i]) ? x1[i] : x2[i];
+    }
+    report<float>("quadratic::solve (float)", t,
+                  small_root_accuracy<float>(a, b, c, small_f));
+
+    auto real_roots = ranges::count(kind, quadratic::Roots::real);
+    println("\n{} of {} equations have two real roots", real_roots,
+            num_equations);
+}
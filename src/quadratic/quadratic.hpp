@@ -0,0 +1,119 @@
+#pragma once
+
+// Batched, numerically stable quadratic solver
+//
+// basic_concepts_ii solves x^2 + 5000x + 0.25 = 0 with
+// `(-b + sqrt(b*b - 4ac)) / 2a`. With b^2 >> 4ac, sqrt(b^2 - 4ac) ~ |b| and
+// `-b + sqrt(...)` subtracts two nearly equal numbers: in float, every
+// significant digit of the small root is lost (catastrophic cancellation).
+//
+// The stable formulation never subtracts like-signed values:
+//   q  = -(b + sign(b) * sqrt(b^2 - 4ac)) / 2     (b and the sqrt add up)
+//   x1 = q / a,   x2 = c / q                        (Vieta: x1 * x2 = c / a)
+//
+// `solve` works on structure-of-arrays spans of a, b and c, one SIMD
+// register of equations at a time; the special cases are handled with lane
+// masks instead of branches:
+//   - disc < 0  -> `Roots::complex`: x1 = real part, x2 = |imaginary part|
+//   - a == 0    -> `Roots::linear`:  x1 = x2 = -c / b
+//   - a == b == 0 -> `Roots::none` (c != 0) or `Roots::all` (c == 0), NaN
+// Two real roots come back ordered (x1 <= x2).
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <experimental/simd>
+#include <limits>
+#include <span>
+
+namespace quadratic {
+
+namespace stdx = std::experimental;
+
+enum class Roots : std::uint8_t { real, complex, linear, none, all };
+
+template <std::floating_point T> struct Solution {
+    T x1;
+    T x2;
+    Roots kind;
+};
+
+// Single equation, same semantics as `solve` (used for the tail)
+template <std::floating_point T> //
+auto solve_one(T a, T b, T c) -> Solution<T> {
+    constexpr T nan = std::numeric_limits<T>::quiet_NaN();
+    if (a == 0) {
+        if (b == 0) {
+            return {nan, nan, c == 0 ? Roots::all : Roots::none};
+        }
+        return {-c / b, -c / b, Roots::linear};
+    }
+    T disc = (b * b) - (4 * a * c);
+    if (disc < 0) {
+        T re = -b / (2 * a);
+        T im = std::sqrt(-disc) / std::abs(2 * a);
+        return {re, im, Roots::complex};
+    }
+    T q = -(b + std::copysign(std::sqrt(disc), b)) / 2;
+    T x1 = q / a;
+    T x2 = q == 0 ? T{0} : c / q; // b == c == 0: both roots are 0
+    return {std::min(x1, x2), std::max(x1, x2), Roots::real};
+}
+
+template <std::floating_point T>
+void solve(std::span<const T> a, std::span<const T> b, std::span<const T> c,
+           std::span<T> x1, std::span<T> x2, std::span<Roots> kind) {
+    using V = stdx::native_simd<T>;
+    constexpr T nan = std::numeric_limits<T>::quiet_NaN();
+    std::size_t i = 0;
+    for (; i + V::size() <= a.size(); i += V::size()) {
+        V va{a.data() + i, stdx::element_aligned};
+        V vb{b.data() + i, stdx::element_aligned};
+        V vc{c.data() + i, stdx::element_aligned};
+
+        V disc = (vb * vb) - (4 * va * vc);
+        auto complex = disc < 0;
+        V root = stdx::sqrt(stdx::abs(disc));
+
+        // real roots (stable form)
+        V sign_root = root;
+        where(vb < 0, sign_root) = -root;
+        V q = -(vb + sign_root) / 2;
+        V r1 = q / va;
+        V r2 = vc / q;
+        where(q == 0, r2) = V{0};
+        V lo = stdx::min(r1, r2);
+        V hi = stdx::max(r1, r2);
+
+        // complex pair
+        where(complex, lo) = -vb / (2 * va);
+        where(complex, hi) = root / stdx::abs(2 * va);
+
+        // degenerate
+        auto linear = va == 0;
+        auto constant = linear && vb == 0;
+        where(linear, lo) = -vc / vb;
+        where(linear, hi) = lo;
+        where(constant, lo) = V{nan};
+        where(constant, hi) = V{nan};
+
+        lo.copy_to(x1.data() + i, stdx::element_aligned);
+        hi.copy_to(x2.data() + i, stdx::element_aligned);
+        for (std::size_t j = 0; j < V::size(); j++) {
+            kind[i + j] = constant[j]  ? (vc[j] == 0 ? Roots::all : Roots::none)
+                          : linear[j]  ? Roots::linear
+                          : complex[j] ? Roots::complex
+                                       : Roots::real;
+        }
+    }
+    for (; i < a.size(); i++) {
+        auto s = solve_one(a[i], b[i], c[i]);
+        x1[i] = s.x1;
+        x2[i] = s.x2;
+        kind[i] = s.kind;
+    }
+}
+
+} // namespace quadratic
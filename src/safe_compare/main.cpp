@@ -0,0 +1,103 @@
+#include <cstddef>
+#include <cstdint>
+#include <print>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "safe_compare/safe_compare.hpp"
+
+using namespace std;
+
+#define PRINT_VAR(var) std::println("{} = {}", #var, var);
+
+constexpr size_t num_values = 16'000'000;
+constexpr int reps = 5;
+
+template <typename T> //
+auto make_column(T lo, T hi) -> vector<T> {
+    mt19937_64 rng{7};
+    uniform_int_distribution<T> dist{lo, hi};
+    vector<T> column(num_values);
+    for (auto &v : column) {
+        v = dist(rng);
+    }
+    return column;
+}
+
+// The baseline: one `std::cmp_greater` per element, packed the same way
+template <typename T, typename U>
+void naive_cmp_greater(span<const T> a, U b, span<uint64_t> out) {
+    for (size_t w = 0; w < safe_compare::mask_words(a.size()); w++) {
+        uint64_t word = 0;
+        for (size_t i = w * 64; i < min(a.size(), (w + 1) * 64); i++) {
+            word |= uint64_t{std::cmp_greater(a[i], b)} << (i % 64);
+        }
+        out[w] = word;
+    }
+}
+
+template <typename T, typename U>
+void run(const char *label, const vector<T> &column, U b) {
+    println("\n{}:", label);
+    vector<uint64_t> expected(safe_compare::mask_words(column.size()));
+    vector<uint64_t> mask(expected.size());
+    span<const T> a{column};
+
+    auto t = bench::time_best(reps, [&] {
+        naive_cmp_greater(a, b, span{expected});
+        bench::do_not_optimize(expected.data());
+    });
+    bench::report("loop over std::cmp_greater", t, num_values, "values");
+
+    t = bench::time_best(reps, [&] {
+        safe_compare::cmp_greater(a, b, span{mask});
+        bench::do_not_optimize(mask.data());
+    });
+    bench::report("safe_compare::cmp_greater", t, num_values, "values");
+
+    auto selected = safe_compare::to_selection(mask, column.size()).size();
+    println("  {} selected, masks {}", selected,
+            mask == expected ? "match" : "DIFFER");
+}
+
+auto main() -> int {
+    println("Safe Compare - array-wide mixed-sign comparison kernels");
+
+    println("\nthe scalar case from basic_concepts_i:");
+    unsigned u_pos = 4;
+    int neg = -3;
+    vector<unsigned> u_col{u_pos};
+    vector<uint64_t> mask(1);
+    safe_compare::cmp_greater(span<const unsigned>{u_col}, neg, span{mask});
+    // the wrong answer is the point here
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-compare"
+    PRINT_VAR(u_pos > neg)
+#pragma GCC diagnostic pop
+    PRINT_VAR(std::cmp_greater(u_pos, neg))
+    PRINT_VAR(mask[0] == 1)
+
+    println("\n{} values per column:", num_values);
+    run("int32 column > 0U", make_column<int32_t>(-1000, 1000), 0U);
+    run("uint32 column > -1", make_column<uint32_t>(0, 4'000'000'000U), -1);
+    run("int16 column > uint64_t{100}", make_column<int16_t>(-500, 500),
+        uint64_t{100});
+    run("uint64 column > int64_t{-5}",
+        make_column<uint64_t>(0, uint64_t{1} << 63U), int64_t{-5});
+
+    println("\nin_range<int16_t> over an int32 column:");
+    auto column = make_column<int32_t>(-70'000, 70'000);
+    vector<uint64_t> in_mask(safe_compare::mask_words(num_values));
+    auto t = bench::time_best(reps, [&] {
+        safe_compare::in_range<int16_t>(span<const int32_t>{column},
+                                        span{in_mask});
+        bench::do_not_optimize(in_mask.data());
+    });
+    bench::report("safe_compare::in_range", t, num_values, "values");
+    println("  {} of {} fit in int16_t",
+            safe_compare::to_selection(in_mask, num_values).size(),
+            num_values);
+}
@@ -0,0 +1,230 @@
+#pragma once
+
+// Array-wide mixed-sign safe comparisons
+//
+// `u_pos > neg` (unsigned vs int) converts `neg` to unsigned and gets the
+// wrong answer; `std::cmp_greater(u_pos, neg)` compares the mathematical
+// values. These kernels apply the `std::cmp_*` semantics to whole columns and
+// write one bit per element into a bitmask (bit `i % 64` of word `i / 64`),
+// which `to_selection` can turn into an index list.
+//
+// SIMD formulation (no lane is ever compared with the wrong sign):
+//   1. widen both operands to the larger of the two widths, keeping their
+//      value (sign-extend signed, zero-extend unsigned)
+//   2. reinterpret both as unsigned of that width, remembering which lanes
+//      held a negative value
+//   3. a < b  <=>  (a negative and b not)
+//                  or (same sign and a < b as unsigned bits)
+//      since two's complement keeps order within each sign
+//
+// The trailing `size % 64` elements use the scalar `std::cmp_*` functions.
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <experimental/simd>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace safe_compare {
+
+namespace stdx = std::experimental;
+
+// Number of 64-bit words needed for a bitmask over `n` elements
+constexpr auto mask_words(std::size_t n) -> std::size_t {
+    return (n + 63) / 64;
+}
+
+namespace detail {
+
+// unsigned type as wide as the wider of `T` and `U`
+template <typename T, typename U>
+using wide_bits_t =
+    std::make_unsigned_t<std::conditional_t<(sizeof(T) >= sizeof(U)), T, U>>;
+
+template <typename W>
+inline constexpr std::size_t lanes = stdx::native_simd<W>::size();
+
+template <typename X, typename W>
+using simd_t = stdx::fixed_size_simd<X, lanes<W>>;
+
+// Lane values as `W` bits, plus which lanes were negative
+template <typename W> struct Widened {
+    simd_t<W, W> bits;
+    typename simd_t<W, W>::mask_type negative;
+};
+
+template <typename W, typename T> //
+auto widen(const simd_t<T, W> &v) -> Widened<W> {
+    if constexpr (std::is_signed_v<T>) {
+        using S = std::make_signed_t<W>;
+        auto bits = stdx::static_simd_cast<simd_t<W, W>>(
+            stdx::static_simd_cast<simd_t<S, W>>(v));
+        constexpr auto max_signed =
+            static_cast<W>(std::numeric_limits<S>::max());
+        return {bits, bits > max_signed};
+    } else {
+        auto bits = stdx::static_simd_cast<simd_t<W, W>>(v);
+        return {bits, typename simd_t<W, W>::mask_type{false}};
+    }
+}
+
+template <typename W> //
+auto less(const Widened<W> &a, const Widened<W> &b) {
+    return (a.negative && !b.negative) ||
+           (a.negative == b.negative && a.bits < b.bits);
+}
+
+// All lanes of `mask` as the low bits of a word: one `copy_to` into bytes
+// of 0/1, then each 8 bytes become 8 bits with one multiply (bit k of the
+// product's top byte collects lane k; no carries reach it)
+template <typename Mask> //
+auto to_bits(const Mask &mask) -> std::uint64_t {
+    constexpr std::size_t width = Mask::size();
+    static_assert(width <= 64);
+    std::array<bool, (width + 7) / 8 * 8> lanes{};
+    mask.copy_to(lanes.data(), stdx::element_aligned);
+    std::uint64_t bits = 0;
+    for (std::size_t byte = 0; byte < lanes.size(); byte += 8) {
+        std::uint64_t eight = 0;
+        std::memcpy(&eight, lanes.data() + byte, sizeof(eight));
+        if constexpr (std::endian::native == std::endian::big) {
+            eight = std::byteswap(eight);
+        }
+        bits |= ((eight * 0x0102'0408'1020'4080) >> 56) << byte;
+    }
+    return bits;
+}
+
+// Runs `simd_op(i)` (mask for elements [i, i + lanes)) over all full
+// 64-element blocks and `scalar_op(i)` over the tail, packing results into
+// `out`
+template <typename W, typename SimdOp, typename ScalarOp>
+void pack(std::size_t n, std::span<std::uint64_t> out, SimdOp simd_op,
+          ScalarOp scalar_op) {
+    constexpr std::size_t width = lanes<W>;
+    static_assert(64 % width == 0);
+    std::size_t full = n / 64;
+    for (std::size_t w = 0; w < full; w++) {
+        std::uint64_t word = 0;
+        for (std::size_t base = 0; base < 64; base += width) {
+            word |= to_bits(simd_op((w * 64) + base)) << base;
+        }
+        out[w] = word;
+    }
+    if (full * 64 < n) {
+        std::uint64_t word = 0;
+        for (std::size_t i = full * 64; i < n; i++) {
+            word |= std::uint64_t{scalar_op(i)} << (i % 64);
+        }
+        out[full] = word;
+    }
+}
+
+} // namespace detail
+
+// out[i] = std::cmp_less(a[i], b[i])
+template <std::integral T, std::integral U>
+void cmp_less(std::span<const T> a, std::span<const U> b,
+              std::span<std::uint64_t> out) {
+    using W = detail::wide_bits_t<T, U>;
+    using detail::simd_t;
+    detail::pack<W>(
+        a.size(), out,
+        [&](std::size_t i) {
+            auto va = detail::widen<W>(
+                simd_t<T, W>{a.data() + i, stdx::element_aligned});
+            auto vb = detail::widen<W>(
+                simd_t<U, W>{b.data() + i, stdx::element_aligned});
+            return detail::less(va, vb);
+        },
+        [&](std::size_t i) { return std::cmp_less(a[i], b[i]); });
+}
+
+// out[i] = std::cmp_less(a[i], b)
+template <std::integral T, std::integral U>
+void cmp_less(std::span<const T> a, U b, std::span<std::uint64_t> out) {
+    using W = detail::wide_bits_t<T, U>;
+    using detail::simd_t;
+    auto vb = detail::widen<W>(simd_t<U, W>{b});
+    detail::pack<W>(
+        a.size(), out,
+        [&](std::size_t i) {
+            auto va = detail::widen<W>(
+                simd_t<T, W>{a.data() + i, stdx::element_aligned});
+            return detail::less(va, vb);
+        },
+        [&](std::size_t i) { return std::cmp_less(a[i], b); });
+}
+
+// out[i] = std::cmp_greater(a[i], b[i])
+template <std::integral T, std::integral U>
+void cmp_greater(std::span<const T> a, std::span<const U> b,
+                 std::span<std::uint64_t> out) {
+    using W = detail::wide_bits_t<T, U>;
+    using detail::simd_t;
+    detail::pack<W>(
+        a.size(), out,
+        [&](std::size_t i) {
+            auto va = detail::widen<W>(
+                simd_t<T, W>{a.data() + i, stdx::element_aligned});
+            auto vb = detail::widen<W>(
+                simd_t<U, W>{b.data() + i, stdx::element_aligned});
+            return detail::less(vb, va);
+        },
+        [&](std::size_t i) { return std::cmp_greater(a[i], b[i]); });
+}
+
+// out[i] = std::cmp_greater(a[i], b)
+template <std::integral T, std::integral U>
+void cmp_greater(std::span<const T> a, U b, std::span<std::uint64_t> out) {
+    using W = detail::wide_bits_t<T, U>;
+    using detail::simd_t;
+    auto vb = detail::widen<W>(simd_t<U, W>{b});
+    detail::pack<W>(
+        a.size(), out,
+        [&](std::size_t i) {
+            auto va = detail::widen<W>(
+                simd_t<T, W>{a.data() + i, stdx::element_aligned});
+            return detail::less(vb, va);
+        },
+        [&](std::size_t i) { return std::cmp_greater(a[i], b); });
+}
+
+// out[i] = std::in_range<R>(a[i])
+template <std::integral R, std::integral T>
+void in_range(std::span<const T> a, std::span<std::uint64_t> out) {
+    using W = detail::wide_bits_t<T, R>;
+    using detail::simd_t;
+    auto lo = detail::widen<W>(simd_t<R, W>{std::numeric_limits<R>::min()});
+    auto hi = detail::widen<W>(simd_t<R, W>{std::numeric_limits<R>::max()});
+    detail::pack<W>(
+        a.size(), out,
+        [&](std::size_t i) {
+            auto va = detail::widen<W>(
+                simd_t<T, W>{a.data() + i, stdx::element_aligned});
+            return !detail::less(va, lo) && !detail::less(hi, va);
+        },
+        [&](std::size_t i) { return std::in_range<R>(a[i]); });
+}
+
+// Indices of the set bits of a bitmask over `n` elements
+inline auto to_selection(std::span<const std::uint64_t> mask, std::size_t n)
+    -> std::vector<std::uint32_t> {
+    std::vector<std::uint32_t> selection;
+    for (std::size_t w = 0; w < mask_words(n); w++) {
+        for (auto word = mask[w]; word != 0; word &= word - 1) {
+            auto bit = static_cast<std::size_t>(std::countr_zero(word));
+            selection.push_back(static_cast<std::uint32_t>((w * 64) + bit));
+        }
+    }
+    return selection;
+}
+
+} // namespace safe_compare
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <print>
+#include <thread>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "sharded_counter/sharded_counter.hpp"
+
+using namespace std;
+
+#define PRINT_VAR(var) std::println("{} = {}", #var, var);
+
+constexpr uint64_t adds_per_thread = 10'000'000;
+constexpr size_t max_threads = 256;
+constexpr int reps = 3;
+
+using sharded_counter::Padded;
+
+// basic_concepts_iv
+struct Empty {};
+struct Y {
+    int i;
+    Empty e;
+};
+struct Z {
+    int i;
+    [[no_unique_address]] Empty e;
+};
+
+// Run `body(thread_index)` on `num_threads` threads at once
+template <typename F> auto time_threads(size_t num_threads, F body) -> double {
+    return bench::time_best(reps, [&] {
+        vector<jthread> threads;
+        threads.reserve(num_threads);
+        for (size_t t = 0; t < num_threads; t++) {
+            threads.emplace_back([&body, t] { body(t); });
+        }
+    });
+}
+
+void bench_counters(size_t num_threads) {
+    println("\n{} thread(s), {} adds each:", num_threads, adds_per_thread);
+    auto total = static_cast<double>(num_threads * adds_per_thread);
+    auto expected = (reps * num_threads * adds_per_thread);
+
+    atomic<uint64_t> shared{0};
+    auto t = time_threads(num_threads, [&](size_t) {
+        for (uint64_t i = 0; i < adds_per_thread; i++) {
+            shared.fetch_add(1, memory_order_relaxed);
+        }
+    });
+    bench::report("one shared atomic", t, total, "adds");
+
+    // one slot per thread, but 8 slots per cache line
+    array<atomic<uint64_t>, max_threads> packed{};
+    t = time_threads(num_threads, [&](size_t thread) {
+        for (uint64_t i = 0; i < adds_per_thread; i++) {
+            packed[thread].fetch_add(1, memory_order_relaxed);
+        }
+    });
+    bench::report("packed atomic per thread", t, total, "adds");
+
+    vector<Padded<atomic<uint64_t>>> padded(num_threads);
+    t = time_threads(num_threads, [&](size_t thread) {
+        for (uint64_t i = 0; i < adds_per_thread; i++) {
+            padded[thread].value.fetch_add(1, memory_order_relaxed);
+        }
+    });
+    bench::report("Padded atomic per thread", t, total, "adds");
+
+    sharded_counter::ShardedCounter counter;
+    t = time_threads(num_threads, [&](size_t) {
+        for (uint64_t i = 0; i < adds_per_thread; i++) {
+            counter.add();
+        }
+    });
+    bench::report("ShardedCounter", t, total, "adds");
+
+    uint64_t packed_sum = 0;
+    uint64_t padded_sum = 0;
+    for (size_t i = 0; i < num_threads; i++) {
+        packed_sum += packed[i].load();
+        padded_sum += padded[i].value.load();
+    }
+    println("  totals match: {}", shared.load() == expected &&
+                                      packed_sum == expected &&
+                                      padded_sum == expected &&
+                                      counter.read() == expected);
+}
+
+auto main() -> int {
+    println("Sharded counter - per-thread counters on separate cache lines");
+
+    // basic_concepts_iv: padding inside one struct...
+    auto sizeof_Y = sizeof(Y);
+    auto sizeof_Z = sizeof(Z);
+    PRINT_VAR(sizeof_Y)
+    PRINT_VAR(sizeof_Z)
+    // ...and between objects written by different threads
+    PRINT_VAR(sharded_counter::cache_line)
+    auto sizeof_atomic = sizeof(atomic<uint64_t>);
+    auto sizeof_padded = sizeof(Padded<atomic<uint64_t>>);
+    PRINT_VAR(sizeof_atomic)
+    PRINT_VAR(sizeof_padded)
+
+    // Min/max/sum of per-thread observations, merged on read
+    struct Stats {
+        uint64_t count = 0;
+        uint64_t sum = 0;
+        uint64_t max = 0;
+    };
+    auto merge = [](Stats a, const Stats &b) {
+        return Stats{.count = a.count + b.count,
+                     .sum = a.sum + b.sum,
+                     .max = std::max(a.max, b.max)};
+    };
+    sharded_counter::ShardedAccumulator<Stats, decltype(merge)> latencies{
+        {}, merge};
+    {
+        vector<jthread> threads;
+        for (uint64_t t = 0; t < 4; t++) {
+            threads.emplace_back([&, t] {
+                for (uint64_t i = 1; i <= 1000; i++) {
+                    latencies.add({.count = 1, .sum = i * (t + 1),
+                                   .max = i * (t + 1)});
+                }
+            });
+        }
+    }
+    auto stats = latencies.read();
+    PRINT_VAR(stats.count)
+    PRINT_VAR(stats.sum)
+    PRINT_VAR(stats.max)
+
+    auto cores = max<size_t>(thread::hardware_concurrency(), 1);
+    PRINT_VAR(cores)
+    for (size_t n = 1; n < cores; n *= 2) {
+        bench_counters(n);
+    }
+    bench_counters(min(cores, max_threads));
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+// Per-thread sharded counters (no false sharing)
+//
+// basic_concepts_iv looks at padding within one struct (`sizeof(Y)` vs
+// `sizeof(Z)`); with threads, the padding that matters is between objects.
+// Cores own memory a cache line at a time, so two counters in the same line
+// bounce that line between the cores writing them, even though no value is
+// shared ("false sharing"), and one `std::atomic` written by every thread is
+// the same problem with real sharing.
+//
+//   - `Padded<T>` - `T` alone on its own cache line(s), aligned and sized to
+//     `std::hardware_destructive_interference_size`
+//   - `ShardedCounter` - one padded atomic per shard; a thread always adds to
+//     the same shard (threads are numbered on first use, modulo the shard
+//     count), so with at least as many shards as threads no line is written
+//     by two cores. `read()` sums the shards.
+//   - `ShardedAccumulator<T, Combine>` - the same for any value: each shard
+//     is a `T` and a spin lock that in practice only its own thread takes;
+//     `read()` folds the shards with `Combine`
+//
+// Reads are not snapshots: adds that race with `read()` may or may not be
+// included, as with any relaxed counter.
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace sharded_counter {
+
+// gcc warns that the value may change between compiler versions and
+// `-mtune`s; it is only used for layout inside this program, never shared
+// across an ABI boundary
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winterference-size"
+#endif
+inline constexpr std::size_t cache_line =
+    std::hardware_destructive_interference_size;
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+// `T` on cache lines of its own (`sizeof` rounds up to the alignment)
+template <typename T> struct alignas(cache_line) Padded {
+    T value{};
+};
+
+namespace detail {
+
+inline std::atomic<std::size_t> next_thread_index{0};
+
+// 0, 1, 2, ... in order of each thread's first call
+inline auto this_thread_index() -> std::size_t {
+    thread_local const std::size_t index =
+        next_thread_index.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+inline auto default_shards() -> std::size_t {
+    return std::bit_ceil(
+        std::max<std::size_t>(std::thread::hardware_concurrency(), 1));
+}
+
+} // namespace detail
+
+class ShardedCounter {
+  public:
+    // `shards` is rounded up to a power of two
+    explicit ShardedCounter(std::size_t shards = detail::default_shards())
+        : shards_(std::bit_ceil(std::max<std::size_t>(shards, 1))) {}
+
+    void add(std::uint64_t n = 1) {
+        shard().value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] auto read() const -> std::uint64_t {
+        std::uint64_t total = 0;
+        for (const auto &s : shards_) {
+            total += s.value.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    void reset() {
+        for (auto &s : shards_) {
+            s.value.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    [[nodiscard]] auto num_shards() const -> std::size_t {
+        return shards_.size();
+    }
+
+  private:
+    auto shard() -> Padded<std::atomic<std::uint64_t>> & {
+        return shards_[detail::this_thread_index() & (shards_.size() - 1)];
+    }
+
+    std::vector<Padded<std::atomic<std::uint64_t>>> shards_;
+};
+
+// `Combine(T, T) -> T` must be associative and commutative with `identity`
+// (sum, min, max, a struct of those, ...)
+template <typename T, typename Combine = std::plus<T>>
+class ShardedAccumulator {
+  public:
+    explicit ShardedAccumulator(T identity = T{}, Combine combine = {},
+                                std::size_t shards = detail::default_shards())
+        : identity_{identity}, combine_{std::move(combine)},
+          shards_(std::bit_ceil(std::max<std::size_t>(shards, 1))) {
+        for (auto &s : shards_) {
+            s.value.total = identity_;
+        }
+    }
+
+    void add(const T &value) {
+        auto &s = shard();
+        lock(s);
+        s.value.total = combine_(s.value.total, value);
+        s.value.busy.clear(std::memory_order_release);
+    }
+
+    [[nodiscard]] auto read() -> T {
+        T total = identity_;
+        for (auto &s : shards_) {
+            lock(s);
+            total = combine_(total, s.value.total);
+            s.value.busy.clear(std::memory_order_release);
+        }
+        return total;
+    }
+
+    void reset() {
+        for (auto &s : shards_) {
+            lock(s);
+            s.value.total = identity_;
+            s.value.busy.clear(std::memory_order_release);
+        }
+    }
+
+  private:
+    struct Shard {
+        std::atomic_flag busy;
+        T total;
+    };
+
+    static void lock(Padded<Shard> &s) {
+        while (s.value.busy.test_and_set(std::memory_order_acquire)) {
+            while (s.value.busy.test(std::memory_order_relaxed)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    auto shard() -> Padded<Shard> & {
+        return shards_[detail::this_thread_index() & (shards_.size() - 1)];
+    }
+
+    T identity_;
+    Combine combine_;
+    std::vector<Padded<Shard>> shards_;
+};
+
+} // namespace sharded_counter
@@ -0,0 +1,166 @@
+#include <cstddef>
+#include <cstdint>
+#include <experimental/simd>
+#include <print>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "soa_vector/soa_vector.hpp"
+
+using namespace std;
+namespace stdx = std::experimental;
+
+#define PRINT_VAR(var) std::println("{} = {}", #var, var);
+
+constexpr size_t num_particles = 2'000'000;
+constexpr int reps = 5;
+
+// basic_concepts_iii
+struct SB {
+    int x;
+    int y;
+};
+
+// 32 bytes, of which a scan over one member uses 4
+struct Particle {
+    float x, y, z;
+    float vx, vy, vz;
+    float mass;
+    int32_t id;
+};
+
+using soa_vector::SoaVector;
+
+constexpr size_t mass = 6; // member index of `Particle::mass`
+
+auto simd_sum(span<const float> values) -> float {
+    using V = stdx::native_simd<float>;
+    V sum = 0;
+    size_t i = 0;
+    for (; i + V::size() <= values.size(); i += V::size()) {
+        sum += V{values.data() + i, stdx::element_aligned};
+    }
+    float total = stdx::reduce(sum);
+    for (; i < values.size(); i++) {
+        total += values[i];
+    }
+    return total;
+}
+
+void bench_scans() {
+    println("\n{} particles ({} bytes each as a struct):", num_particles,
+            sizeof(Particle));
+    mt19937 rng{20};
+    uniform_real_distribution<float> dist{0, 1};
+    vector<Particle> aos;
+    SoaVector<Particle> soa;
+    aos.reserve(num_particles);
+    soa.reserve(num_particles);
+    for (size_t i = 0; i < num_particles; i++) {
+        Particle p{dist(rng),         dist(rng), dist(rng), dist(rng),
+                   dist(rng),         dist(rng), dist(rng),
+                   static_cast<int32_t>(i)};
+        aos.push_back(p);
+        soa.push_back(p);
+    }
+    auto n = static_cast<double>(num_particles);
+
+    println("sum of mass:");
+    float aos_sum = 0;
+    auto t = bench::time_best(reps, [&] {
+        aos_sum = 0;
+        for (const auto &p : aos) {
+            aos_sum += p.mass;
+        }
+    });
+    bench::report("vector<Particle>", t, n, "elements");
+    float proxy_sum = 0;
+    t = bench::time_best(reps, [&] {
+        proxy_sum = 0;
+        for (auto [x, y, z, vx, vy, vz, m, id] : soa) {
+            proxy_sum += m;
+        }
+    });
+    bench::report("SoaVector, structured bindings", t, n, "elements");
+    float column_sum = 0;
+    t = bench::time_best(reps, [&] {
+        column_sum = 0;
+        for (auto m : soa.column<mass>()) {
+            column_sum += m;
+        }
+    });
+    bench::report("SoaVector, column span", t, n, "elements");
+    float simd_total = 0;
+    t = bench::time_best(reps,
+                         [&] { simd_total = simd_sum(soa.column<mass>()); });
+    bench::report("SoaVector, column span + native_simd", t, n, "elements");
+    println("  sums match: {} (SIMD: {} vs {}, reassociated)",
+            aos_sum == proxy_sum && proxy_sum == column_sum, simd_total,
+            column_sum);
+
+    println("count of mass > 0.9:");
+    size_t aos_count = 0;
+    t = bench::time_best(reps, [&] {
+        aos_count = 0;
+        for (const auto &p : aos) {
+            aos_count += p.mass > 0.9F ? 1 : 0;
+        }
+    });
+    bench::report("vector<Particle>", t, n, "elements");
+    size_t soa_count = 0;
+    t = bench::time_best(reps, [&] {
+        soa_count = 0;
+        for (auto m : soa.column<mass>()) {
+            soa_count += m > 0.9F ? 1 : 0;
+        }
+    });
+    bench::report("SoaVector, column span", t, n, "elements");
+    println("  counts match: {}", aos_count == soa_count);
+
+    println("x += vx * dt (two members):");
+    constexpr float dt = 0.01F;
+    t = bench::time_best(reps, [&] {
+        for (auto &p : aos) {
+            p.x += p.vx * dt;
+        }
+    });
+    bench::report("vector<Particle>", t, n, "elements");
+    t = bench::time_best(reps, [&] {
+        auto x = soa.column<0>();
+        auto vx = soa.column<3>();
+        for (size_t i = 0; i < x.size(); i++) {
+            x[i] += vx[i] * dt;
+        }
+    });
+    bench::report("SoaVector, column spans", t, n, "elements");
+    println("  positions match: {}",
+            aos[num_particles / 2].x == soa.column<0>()[num_particles / 2]);
+}
+
+auto main() -> int {
+    println("SoA vector - one column per aggregate member");
+
+    // basic_concepts_iii: `SB arr[]` iterated with `auto [x1, y1]`, as
+    // columns
+    SoaVector<SB> arr;
+    arr.push_back({.x = 1, .y = 2});
+    arr.push_back({.x = 3, .y = 4});
+    arr.push_back({.x = 5, .y = 6});
+    for (auto [x1, y1] : arr) {
+        println("{}, {}", x1, y1);
+    }
+    // bindings refer into the columns
+    for (auto [x1, y1] : arr) {
+        x1 *= 10;
+    }
+    println("x column: {}", arr.column<0>());
+    println("y column: {}", arr.column<1>());
+    SB second = arr[1];
+    PRINT_VAR(second.x)
+    PRINT_VAR(soa_vector::member_count<SB>)
+    PRINT_VAR(soa_vector::member_count<Particle>)
+
+    bench_scans();
+}
@@ -0,0 +1,354 @@
+#pragma once
+
+// Structure-of-arrays vector for plain aggregates
+//
+// `std::vector<SB>` (basic_concepts_iii: `struct SB { int x; int y; }`)
+// stores whole structs back to back, so a loop over one member still pulls
+// every other member through the cache. `SoaVector<SB>` stores one
+// `std::vector` per member instead:
+//   - the members are found without macros or reflection: their count is the
+//     largest N for which `SB{f_1, ..., f_N}` compiles with placeholders that
+//     convert to anything, and their types come from a structured binding
+//     `auto &[m0, ..., mN] = sb` (up to `max_members`)
+//   - `column<I>()` - a `std::span` over member I alone, for SIMD or
+//     auto-vectorized loops
+//   - `soa[i]` and iteration yield a proxy `Ref` of references into every
+//     column, which supports `auto [x, y] = soa[i]` (bindings refer to the
+//     columns), conversion to `SB` and assignment from `SB`
+//
+// Aggregates only (no bases, reference or array members), like the `SB`
+// above. `bool` members are stored one byte each (not `std::vector<bool>`'s
+// bits), so they get `bool &` references and `std::span<bool>` columns too.
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace soa_vector {
+
+inline constexpr std::size_t max_members = 8;
+
+namespace detail {
+
+// Converts to any member type, in unevaluated brace-init probes only
+struct AnyMember {
+    template <typename U> operator U() const; // NOLINT
+};
+
+template <typename T, std::size_t N>
+constexpr auto brace_constructible() -> bool {
+    return []<std::size_t... I>(std::index_sequence<I...>) {
+        return requires { T{(void(I), AnyMember{})...}; };
+    }(std::make_index_sequence<N>{});
+}
+
+template <typename T> constexpr auto count_members() -> std::size_t {
+    std::size_t n = 0;
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        ((brace_constructible<T, I + 1>() ? n = I + 1 : n), ...);
+    }(std::make_index_sequence<max_members + 1>{});
+    return n;
+}
+
+} // namespace detail
+
+template <typename T>
+concept aggregate = std::is_aggregate_v<T> && !std::is_array_v<T> &&
+                    std::is_default_constructible_v<T> &&
+                    std::is_copy_assignable_v<T>;
+
+template <aggregate T>
+inline constexpr std::size_t member_count = detail::count_members<T>();
+
+// `std::tie` of every member of `value`
+template <typename T>
+    requires aggregate<std::remove_const_t<T>>
+constexpr auto tie_members(T &value) {
+    constexpr auto n = member_count<std::remove_const_t<T>>;
+    static_assert(n >= 1 && n <= max_members,
+                  "1 to max_members aggregate members supported");
+    if constexpr (n == 1) {
+        auto &[m0] = value;
+        return std::tie(m0);
+    } else if constexpr (n == 2) {
+        auto &[m0, m1] = value;
+        return std::tie(m0, m1);
+    } else if constexpr (n == 3) {
+        auto &[m0, m1, m2] = value;
+        return std::tie(m0, m1, m2);
+    } else if constexpr (n == 4) {
+        auto &[m0, m1, m2, m3] = value;
+        return std::tie(m0, m1, m2, m3);
+    } else if constexpr (n == 5) {
+        auto &[m0, m1, m2, m3, m4] = value;
+        return std::tie(m0, m1, m2, m3, m4);
+    } else if constexpr (n == 6) {
+        auto &[m0, m1, m2, m3, m4, m5] = value;
+        return std::tie(m0, m1, m2, m3, m4, m5);
+    } else if constexpr (n == 7) {
+        auto &[m0, m1, m2, m3, m4, m5, m6] = value;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6);
+    } else {
+        auto &[m0, m1, m2, m3, m4, m5, m6, m7] = value;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6, m7);
+    }
+}
+
+namespace detail {
+
+// The column of a `bool` member: `std::vector<bool>` packs bits, so it has
+// no `bool &` to bind `Ref` to and no `data()` for `column<I>()`
+class BoolColumn {
+  public:
+    BoolColumn() = default;
+    BoolColumn(const BoolColumn &other) { *this = other; }
+    BoolColumn(BoolColumn &&other) noexcept { swap(other); }
+    ~BoolColumn() = default;
+
+    auto operator=(const BoolColumn &other) -> BoolColumn & {
+        if (this != &other) {
+            clear();
+            reserve(other.size_);
+            std::copy_n(other.data(), other.size_, data());
+            size_ = other.size_;
+        }
+        return *this;
+    }
+    auto operator=(BoolColumn &&other) noexcept -> BoolColumn & {
+        BoolColumn{std::move(other)}.swap(*this);
+        return *this;
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t { return size_; }
+    auto data() -> bool * { return data_.get(); }
+    [[nodiscard]] auto data() const -> const bool * { return data_.get(); }
+    auto operator[](std::size_t i) -> bool & { return data_[i]; }
+    auto operator[](std::size_t i) const -> const bool & { return data_[i]; }
+
+    void reserve(std::size_t capacity) {
+        if (capacity > capacity_) {
+            auto grown = std::make_unique<bool[]>(capacity);
+            std::copy_n(data(), size_, grown.get());
+            data_ = std::move(grown);
+            capacity_ = capacity;
+        }
+    }
+    void resize(std::size_t size) {
+        reserve(size);
+        if (size > size_) {
+            std::fill(data() + size_, data() + size, false);
+        }
+        size_ = size;
+    }
+    void clear() { size_ = 0; }
+    void push_back(bool value) {
+        if (size_ == capacity_) {
+            reserve(std::max<std::size_t>(2 * capacity_, 16));
+        }
+        data_[size_++] = value;
+    }
+
+    void swap(BoolColumn &other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+  private:
+    std::unique_ptr<bool[]> data_;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 0;
+};
+
+template <typename M>
+using column_t =
+    std::conditional_t<std::is_same_v<M, bool>, BoolColumn, std::vector<M>>;
+
+template <typename Tuple> struct members_of;
+template <typename... Ms> struct members_of<std::tuple<Ms &...>> {
+    using types = std::tuple<Ms...>;
+    using columns = std::tuple<column_t<Ms>...>;
+};
+
+template <typename T>
+using member_tuple =
+    typename members_of<decltype(tie_members(std::declval<T &>()))>::types;
+
+template <typename T>
+using column_tuple =
+    typename members_of<decltype(tie_members(std::declval<T &>()))>::columns;
+
+} // namespace detail
+
+template <aggregate T, std::size_t I>
+using member_t = std::tuple_element_t<I, detail::member_tuple<T>>;
+
+template <aggregate T, bool Const, std::size_t I>
+using member_ref_t =
+    std::conditional_t<Const, const member_t<T, I> &, member_t<T, I> &>;
+
+namespace detail {
+
+template <typename T, bool Const, typename Indices> struct ref_tuple;
+template <typename T, bool Const, std::size_t... I>
+struct ref_tuple<T, Const, std::index_sequence<I...>> {
+    using type = std::tuple<member_ref_t<T, Const, I>...>;
+};
+
+} // namespace detail
+
+// References to one element's member in every column; `Const` for
+// read-only access
+template <aggregate T, bool Const> class Ref {
+    template <std::size_t I> using ref_t = member_ref_t<T, Const, I>;
+
+  public:
+    template <typename... Rs>
+    explicit Ref(Rs &...refs) : refs_{refs...} {}
+
+    template <std::size_t I> [[nodiscard]] auto get() const -> ref_t<I> {
+        return std::get<I>(refs_);
+    }
+
+    // NOLINTNEXTLINE(google-explicit-constructor) - reads like `SB sb = *it`
+    operator T() const {
+        return std::apply([](const auto &...members) { return T{members...}; },
+                          refs_);
+    }
+
+    // Writes every member (`soa[i] = SB{...}`)
+    auto operator=(const T &value) const -> const Ref &
+        requires(!Const)
+    {
+        auto members = tie_members(value);
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ((std::get<I>(refs_) = std::get<I>(members)), ...);
+        }(std::make_index_sequence<member_count<T>>{});
+        return *this;
+    }
+
+  private:
+    typename detail::ref_tuple<T, Const,
+                               std::make_index_sequence<member_count<T>>>::type
+        refs_;
+};
+
+template <aggregate T> class SoaVector {
+    using Columns = detail::column_tuple<T>;
+    static constexpr std::size_t members = member_count<T>;
+
+  public:
+    using value_type = T;
+    using reference = Ref<T, false>;
+    using const_reference = Ref<T, true>;
+
+    template <bool Const> class Iterator {
+        using Owner = std::conditional_t<Const, const SoaVector, SoaVector>;
+
+      public:
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+        Iterator(Owner *owner, std::size_t index)
+            : owner_{owner}, index_{index} {}
+
+        auto operator*() const -> Ref<T, Const> { return (*owner_)[index_]; }
+        auto operator++() -> Iterator & {
+            ++index_;
+            return *this;
+        }
+        auto operator++(int) -> Iterator {
+            auto old = *this;
+            ++index_;
+            return old;
+        }
+        auto operator==(const Iterator &other) const -> bool {
+            return index_ == other.index_;
+        }
+
+      private:
+        Owner *owner_ = nullptr;
+        std::size_t index_ = 0;
+    };
+
+    SoaVector() = default;
+    explicit SoaVector(std::size_t size) { resize(size); }
+
+    [[nodiscard]] auto size() const -> std::size_t {
+        return std::get<0>(columns_).size();
+    }
+    [[nodiscard]] auto empty() const -> bool { return size() == 0; }
+
+    void reserve(std::size_t capacity) {
+        each_column([&](auto &column) { column.reserve(capacity); });
+    }
+    void resize(std::size_t size) {
+        each_column([&](auto &column) { column.resize(size); });
+    }
+    void clear() {
+        each_column([](auto &column) { column.clear(); });
+    }
+
+    void push_back(const T &value) {
+        auto members = tie_members(value);
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (std::get<I>(columns_).push_back(std::get<I>(members)), ...);
+        }(std::make_index_sequence<SoaVector::members>{});
+    }
+
+    auto operator[](std::size_t i) -> reference {
+        return std::apply(
+            [i](auto &...column) { return reference{column[i]...}; },
+            columns_);
+    }
+    auto operator[](std::size_t i) const -> const_reference {
+        return std::apply(
+            [i](const auto &...column) {
+                return const_reference{column[i]...};
+            },
+            columns_);
+    }
+
+    // Member I of every element, contiguous
+    template <std::size_t I> auto column() -> std::span<member_t<T, I>> {
+        auto &column = std::get<I>(columns_);
+        return {column.data(), column.size()};
+    }
+    template <std::size_t I>
+    [[nodiscard]] auto column() const -> std::span<const member_t<T, I>> {
+        const auto &column = std::get<I>(columns_);
+        return {column.data(), column.size()};
+    }
+
+    auto begin() -> Iterator<false> { return {this, 0}; }
+    auto end() -> Iterator<false> { return {this, size()}; }
+    [[nodiscard]] auto begin() const -> Iterator<true> { return {this, 0}; }
+    [[nodiscard]] auto end() const -> Iterator<true> {
+        return {this, size()};
+    }
+
+  private:
+    template <typename F> void each_column(F &&f) {
+        std::apply([&](auto &...column) { (f(column), ...); }, columns_);
+    }
+
+    Columns columns_;
+};
+
+} // namespace soa_vector
+
+// Structured bindings for `Ref`: `auto [x, y] = soa[i]`
+template <typename T, bool Const>
+struct std::tuple_size<soa_vector::Ref<T, Const>>
+    : std::integral_constant<std::size_t, soa_vector::member_count<T>> {};
+
+template <std::size_t I, typename T, bool Const>
+struct std::tuple_element<I, soa_vector::Ref<T, Const>> {
+    using type = soa_vector::member_ref_t<T, Const, I>;
+};
@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <print>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "string_compare/string_compare.hpp"
+
+using namespace std;
+
+#define PRINT_VAR(var) std::println("{} = {}", #var, var);
+
+constexpr size_t num_keys = 1'000'000;
+constexpr int reps = 3;
+
+// Random lowercase keys with lengths in [min_len, max_len], all starting with
+// `prefix` (shared prefixes are what make byte-by-byte comparison slow)
+auto make_keys(size_t min_len, size_t max_len, const string &prefix = "")
+    -> vector<string> {
+    mt19937_64 rng{42};
+    uniform_int_distribution<size_t> len{min_len, max_len};
+    uniform_int_distribution<int> letter{'a', 'z'};
+    vector<string> keys(num_keys);
+    for (auto &key : keys) {
+        key = prefix;
+        auto n = len(rng);
+        for (size_t i = 0; i < n; i++) {
+            key.push_back(static_cast<char>(letter(rng)));
+        }
+    }
+    return keys;
+}
+
+void run(const char *label, const vector<string> &input) {
+    println("\n{}:", label);
+    vector<string> keys;
+    auto reset = [&] { keys = input; };
+
+    auto t = bench::time_best(reps, reset, [&] { ranges::sort(keys); });
+    auto expected = keys;
+    bench::report("std::string operator<=>", t, num_keys, "keys");
+
+    t = bench::time_best(reps, reset, [&] {
+        ranges::sort(keys, [](const string &a, const string &b) {
+            return strcmp(a.c_str(), b.c_str()) < 0;
+        });
+    });
+    bench::report("strcmp", t, num_keys, "keys");
+
+    t = bench::time_best(reps, reset,
+                         [&] { ranges::sort(keys, string_compare::Less{}); });
+    bench::report("string_compare::compare", t, num_keys, "keys");
+
+    if (keys != expected) {
+        println("  !! string_compare order differs from operator<=>");
+    }
+}
+
+auto main() -> int {
+    println("String Compare - SIMD three-way comparison for bulk sorting");
+    println("sorting {} keys per run", num_keys);
+
+    println("\nordering checks:");
+    PRINT_VAR(string_compare::compare("first", "second") < 0)
+    PRINT_VAR(string_compare::compare("abc", "abcd") < 0)
+    PRINT_VAR(string_compare::compare("\xff", "a") > 0)
+    PRINT_VAR(string_compare::compare("same", "same") == 0)
+
+    run("short keys (4-8 bytes)", make_keys(4, 8));
+    run("medium keys (16-32 bytes)", make_keys(16, 32));
+    run("long keys (64-128 bytes)", make_keys(64, 128));
+    run("mixed keys (1-64 bytes)", make_keys(1, 64));
+    run("shared 24-byte prefix + 4-12 bytes",
+        make_keys(4, 12, "tenant/0042/region/emea/"));
+
+    auto keys = make_keys(1, 3);
+    string_compare::sort_unique(keys);
+    println("\nsort_unique over {} 1-3 byte keys leaves {}", num_keys,
+            keys.size());
+}
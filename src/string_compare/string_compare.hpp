@@ -0,0 +1,111 @@
+#pragma once
+
+// Vectorized three-way string comparison
+//
+// `strcmp` and `std::string::operator<=>` (via `char_traits::compare`, i.e.
+// `memcmp`) are both correct, but for short keys most of their cost is call
+// overhead and byte-at-a-time setup. This compares a whole SIMD register of
+// bytes per step and finds the first differing byte from the comparison mask.
+//
+// Ordering matches `std::string::operator<=>`:
+//   - bytes compare as `unsigned char`
+//   - if one string is a prefix of the other, the shorter one is less
+//
+// Uses `std::experimental::simd` (Parallelism TS v2, shipped with libstdc++);
+// the register width follows the target (`-DNATIVE_ARCH=ON` for AVX2/AVX-512).
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <experimental/simd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace string_compare {
+
+namespace stdx = std::experimental;
+
+using byte_simd = stdx::native_simd<unsigned char>;
+
+// Index of the first byte where `a` and `b` differ, or `n` if none do
+inline auto mismatch(const unsigned char *a, const unsigned char *b,
+                     std::size_t n) -> std::size_t {
+    constexpr std::size_t width = byte_simd::size();
+    std::size_t i = 0;
+    for (; i + width <= n; i += width) {
+        byte_simd va{a + i, stdx::element_aligned};
+        byte_simd vb{b + i, stdx::element_aligned};
+        auto differs = va != vb;
+        if (stdx::any_of(differs)) {
+            return i + static_cast<std::size_t>(stdx::find_first_set(differs));
+        }
+    }
+    // tail shorter than a register
+    // - with at least one full register behind it, re-compare the last
+    //   `width` bytes (overlapping bytes are already known to be equal)
+    if (i < n && n >= width) {
+        i = n - width;
+        byte_simd va{a + i, stdx::element_aligned};
+        byte_simd vb{b + i, stdx::element_aligned};
+        auto differs = va != vb;
+        if (stdx::any_of(differs)) {
+            return i + static_cast<std::size_t>(stdx::find_first_set(differs));
+        }
+        return n;
+    }
+    // - short strings: 8 bytes at a time as integers (SWAR)
+    for (; i + 8 <= n; i += 8) {
+        std::uint64_t wa = 0;
+        std::uint64_t wb = 0;
+        std::memcpy(&wa, a + i, 8);
+        std::memcpy(&wb, b + i, 8);
+        if (wa != wb) {
+            auto bit = std::endian::native == std::endian::little
+                           ? std::countr_zero(wa ^ wb)
+                           : std::countl_zero(wa ^ wb);
+            return i + static_cast<std::size_t>(bit / 8);
+        }
+    }
+    for (; i < n; i++) {
+        if (a[i] != b[i]) {
+            return i;
+        }
+    }
+    return n;
+}
+
+inline auto compare(std::string_view a, std::string_view b)
+    -> std::strong_ordering {
+    auto n = std::min(a.size(), b.size());
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    auto *pa = reinterpret_cast<const unsigned char *>(a.data());
+    auto *pb = reinterpret_cast<const unsigned char *>(b.data());
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+    auto i = mismatch(pa, pb, n);
+    if (i < n) {
+        return pa[i] <=> pb[i];
+    }
+    return a.size() <=> b.size();
+}
+
+// Comparator for the standard algorithms
+struct Less {
+    auto operator()(std::string_view a, std::string_view b) const -> bool {
+        return compare(a, b) < 0;
+    }
+};
+
+// Sort `keys` and drop duplicates
+inline void sort_unique(std::vector<std::string> &keys) {
+    std::ranges::sort(keys, Less{});
+    auto dupes = std::ranges::unique(keys, [](const auto &a, const auto &b) {
+        return compare(a, b) == 0;
+    });
+    keys.erase(dupes.begin(), dupes.end());
+}
+
+} // namespace string_compare
@@ -0,0 +1,195 @@
+#include <cstddef>
+#include <cstdint>
+#include <print>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "struct_layout/struct_layout.hpp"
+
+using namespace std;
+
+#define PRINT_VAR(var) std::println("{} = {}", #var, var);
+
+constexpr size_t in_cache_records = 4096;
+constexpr size_t in_memory_records = 4'000'000;
+constexpr int reps = 5;
+
+// basic_concepts_iv
+struct MyStruct {
+    int x;
+};
+struct Empty {};
+struct Y {
+    int i;
+    Empty e;
+};
+struct Z {
+    int i;
+    [[no_unique_address]] Empty e;
+};
+
+// `alignas` on a member: `b` moves to offset 8, but the computed layout
+// (from the types alone) has it at 4 with the same size and alignment
+struct OverAligned {
+    int a;
+    alignas(8) int b;
+    int c;
+    double d;
+};
+static_assert(struct_layout::layout<OverAligned>().size_matches);
+static_assert(struct_layout::layout<OverAligned>().members[1].offset == 4);
+
+// Fields in the order they were thought of: 23 of 56 bytes are padding
+struct Order {
+    bool active;
+    double price;
+    uint8_t side;
+    int64_t quantity;
+    bool urgent;
+    int32_t venue;
+    uint16_t flags;
+    double fee;
+};
+
+// Field names for `PackedTuple::get` (declaration order)
+enum OrderField : uint8_t {
+    active,
+    price,
+    side,
+    quantity,
+    urgent,
+    venue,
+    flags,
+    fee
+};
+
+using PackedOrder = struct_layout::packed_t<Order>;
+
+static_assert(struct_layout::layout<Order>().padding() == 23);
+static_assert(sizeof(PackedOrder) ==
+              struct_layout::layout<Order>().packed_size());
+
+template <size_t N>
+void print_layout(string_view name, const struct_layout::Layout<N> &layout) {
+    println("{}: size {}, align {}, {} bytes of padding{}", name, layout.size,
+            layout.align, layout.padding(),
+            layout.size_matches ? "" : " (computed - differs from sizeof)");
+    for (size_t i = 0; i < N; i++) {
+        const auto &m = layout.members[i];
+        println("  member {}: offset {:>2}, size {}, align {}, padding {}", i,
+                m.offset, m.size, m.align, m.padding);
+    }
+    if (layout.tail_padding != 0) {
+        println("  tail padding {}", layout.tail_padding);
+    }
+}
+
+// Notional value of the active orders: reads 3 of 8 fields per record
+template <typename Record, typename Get>
+auto active_notional(const vector<Record> &records, Get get) -> double {
+    double total = 0;
+    for (const auto &r : records) {
+        if (get.active(r)) {
+            total += get.price(r) * static_cast<double>(get.quantity(r));
+        }
+    }
+    return total;
+}
+
+struct PlainFields {
+    static auto active(const Order &o) -> bool { return o.active; }
+    static auto price(const Order &o) -> double { return o.price; }
+    static auto quantity(const Order &o) -> int64_t { return o.quantity; }
+};
+
+struct PackedFields {
+    static auto active(const PackedOrder &o) -> bool {
+        return o.get<OrderField::active>();
+    }
+    static auto price(const PackedOrder &o) -> double {
+        return o.get<OrderField::price>();
+    }
+    static auto quantity(const PackedOrder &o) -> int64_t {
+        return o.get<OrderField::quantity>();
+    }
+};
+
+void bench_scan(size_t num_records) {
+    mt19937_64 rng{25};
+    vector<Order> orders(num_records);
+    for (auto &o : orders) {
+        auto bits = rng();
+        o = {.active = (bits & 1) != 0,
+             .price = static_cast<double>(bits % 10'000) / 100.0,
+             .side = static_cast<uint8_t>(bits >> 8),
+             .quantity = static_cast<int64_t>((bits >> 16) % 1'000),
+             .urgent = (bits & 2) != 0,
+             .venue = static_cast<int32_t>((bits >> 32) % 64),
+             .flags = static_cast<uint16_t>(bits >> 40),
+             .fee = 0.25};
+    }
+    vector<PackedOrder> packed(num_records);
+    for (size_t i = 0; i < num_records; i++) {
+        packed[i] = struct_layout::pack(orders[i]);
+    }
+
+    println("\n{} records ({} KiB as Order, {} KiB packed):", num_records,
+            num_records * sizeof(Order) >> 10,
+            num_records * sizeof(PackedOrder) >> 10);
+    double plain_total = 0;
+    auto t = bench::time_best(
+        reps, [&] { plain_total = active_notional(orders, PlainFields{}); });
+    bench::report("Order (declaration order)", t,
+                  static_cast<double>(num_records), "records");
+    double packed_total = 0;
+    t = bench::time_best(reps, [&] {
+        packed_total = active_notional(packed, PackedFields{});
+    });
+    bench::report("PackedTuple (by alignment)", t,
+                  static_cast<double>(num_records), "records");
+    println("  results match: {}", plain_total == packed_total);
+}
+
+auto main() -> int {
+    println("Struct layout - padding report and packed field order");
+
+    print_layout("MyStruct", struct_layout::layout<MyStruct>());
+    print_layout("Y", struct_layout::layout<Y>());
+    print_layout("Z", struct_layout::layout<Z>());
+    PRINT_VAR(sizeof(Z))
+    PRINT_VAR(struct_layout::verify_layout<Y>())
+    PRINT_VAR(struct_layout::verify_layout<Z>())
+    print_layout("OverAligned", struct_layout::layout<OverAligned>());
+    PRINT_VAR(offsetof(OverAligned, b))
+    PRINT_VAR(struct_layout::verify_layout<OverAligned>())
+
+    println("");
+    constexpr auto order_layout = struct_layout::layout<Order>();
+    print_layout("Order", order_layout);
+    PRINT_VAR(order_layout.packed_size())
+    PRINT_VAR(struct_layout::verify_layout<Order>())
+    print_layout("PackedOrder (storage order)", PackedOrder::layout);
+    PRINT_VAR(PackedOrder::offset<OrderField::active>())
+    PRINT_VAR(PackedOrder::offset<OrderField::price>())
+
+    Order order{.active = true,
+                .price = 9.5,
+                .side = 1,
+                .quantity = 3,
+                .urgent = false,
+                .venue = 7,
+                .flags = 0,
+                .fee = 0.1};
+    auto p = struct_layout::pack(order);
+    p.get<OrderField::quantity>() += 1;
+    auto [is_active, price_, side_, quantity_, urgent_, venue_, flags_,
+          fee_] = p;
+    PRINT_VAR(is_active)
+    PRINT_VAR(quantity_)
+    PRINT_VAR(struct_layout::unpack<Order>(p).quantity)
+
+    bench_scan(in_cache_records);
+    bench_scan(in_memory_records);
+}
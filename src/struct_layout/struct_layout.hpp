@@ -0,0 +1,280 @@
+#pragma once
+
+// Compile-time struct layout and a padding-minimizing field order
+//
+// basic_concepts_iv works out `sizeof(MyStruct)`, `sizeof(Y)` (4 + 1 + 3
+// bytes of padding) and `sizeof(Z)` by hand. For any aggregate:
+//   - `layout<T>()` - each member's offset, size, alignment and the padding
+//     in front of it, plus the tail padding, as a constexpr value. Members
+//     are found like soa_vector does (structured bindings); offsets follow
+//     the C layout rule, each member at the next multiple of its alignment.
+//   - `PackedTuple<Ts...>` - stores `Ts` sorted by decreasing alignment, so
+//     the only padding left is at the end (less than the largest
+//     alignment), while `get<I>()` still takes the declaration index `I`
+//     (an enum of field names works well, as with packed_record)
+//   - `packed_t<T>`, `pack(t)` and `unpack<T>(p)` - the packed tuple of an
+//     aggregate's members, and conversions both ways
+//   - `verify_layout<T>()` - whether every computed offset is where the
+//     member really is (at run time: it compares member addresses)
+//
+// The computation only sees member types, so it is wrong for layouts the C
+// rule doesn't describe: `[[no_unique_address]]` members (basic_concepts_iv's
+// `Z`), `alignas` on a member, and so on. `layout<T>().size_matches` only
+// compares the computed size and alignment with `sizeof(T)`/`alignof(T)`;
+// `alignas(8) int b` after an `int` moves `b` without changing either, so
+// only `verify_layout` catches it. Bitfield members aren't supported.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "soa_vector/soa_vector.hpp"
+
+namespace struct_layout {
+
+using soa_vector::aggregate;
+using soa_vector::member_count;
+using soa_vector::member_t;
+
+namespace detail {
+
+constexpr auto round_up(std::size_t n, std::size_t unit) -> std::size_t {
+    return (n + unit - 1) / unit * unit;
+}
+
+} // namespace detail
+
+struct MemberLayout {
+    std::size_t offset = 0;
+    std::size_t size = 0;
+    std::size_t align = 0;
+    std::size_t padding = 0; // bytes in front of the member
+};
+
+template <std::size_t N> struct Layout {
+    std::array<MemberLayout, N> members{};
+    std::size_t size = 0;
+    std::size_t align = 1;
+    std::size_t tail_padding = 0;
+    // `size` and `align` are `sizeof`/`alignof` (offsets may still differ)
+    bool size_matches = true;
+
+    // Bytes that hold no member
+    [[nodiscard]] constexpr auto padding() const -> std::size_t {
+        auto total = tail_padding;
+        for (const auto &m : members) {
+            total += m.padding;
+        }
+        return total;
+    }
+
+    // Size with the members sorted by decreasing alignment (every size is
+    // a multiple of its alignment, so only tail padding remains)
+    [[nodiscard]] constexpr auto packed_size() const -> std::size_t {
+        std::size_t data = 0;
+        for (const auto &m : members) {
+            data += m.size;
+        }
+        return detail::round_up(data, align);
+    }
+};
+
+// Members of types `Ts`, in order, laid out by the C rule
+template <typename... Ts>
+constexpr auto layout_of() -> Layout<sizeof...(Ts)> {
+    Layout<sizeof...(Ts)> result;
+    std::size_t end = 0;
+    std::size_t i = 0;
+    auto add = [&](std::size_t size, std::size_t align) {
+        auto offset = detail::round_up(end, align);
+        result.members[i++] = {offset, size, align, offset - end};
+        end = offset + size;
+        result.align = std::max(result.align, align);
+    };
+    (add(sizeof(Ts), alignof(Ts)), ...);
+    result.size = detail::round_up(end, result.align);
+    result.tail_padding = result.size - end;
+    return result;
+}
+
+template <aggregate T> constexpr auto layout() -> Layout<member_count<T>> {
+    auto result = []<std::size_t... I>(std::index_sequence<I...>) {
+        return layout_of<member_t<T, I>...>();
+    }(std::make_index_sequence<member_count<T>>{});
+    result.size_matches =
+        result.size == sizeof(T) && result.align == alignof(T);
+    return result;
+}
+
+// Whether `layout<T>()` is the real layout: its size and alignment match and
+// every member is at the computed offset
+template <aggregate T> auto verify_layout() -> bool {
+    constexpr auto computed = layout<T>();
+    T value{};
+    auto members = soa_vector::tie_members(value);
+    auto offset = [&](const auto &member) {
+        return static_cast<std::size_t>(
+            reinterpret_cast<const std::byte *>(std::addressof(member)) -
+            reinterpret_cast<const std::byte *>(std::addressof(value)));
+    };
+    return computed.size_matches &&
+           [&]<std::size_t... I>(std::index_sequence<I...>) {
+               return ((offset(std::get<I>(members)) ==
+                        computed.members[I].offset) &&
+                       ...);
+           }(std::make_index_sequence<member_count<T>>{});
+}
+
+namespace detail {
+
+// `order[slot]` is the declaration index stored at `slot`: decreasing
+// alignment, ties in declaration order
+template <typename... Ts>
+constexpr auto storage_order() -> std::array<std::size_t, sizeof...(Ts)> {
+    constexpr std::array<std::size_t, sizeof...(Ts)> aligns{alignof(Ts)...};
+    std::array<std::size_t, sizeof...(Ts)> order{};
+    for (std::size_t i = 0; i < order.size(); i++) {
+        // insertion sort (std::stable_sort isn't constexpr)
+        auto j = i;
+        while (j > 0 && aligns[order[j - 1]] < aligns[i]) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+    return order;
+}
+
+template <std::size_t N>
+constexpr auto inverse(const std::array<std::size_t, N> &order)
+    -> std::array<std::size_t, N> {
+    std::array<std::size_t, N> slot_of{};
+    for (std::size_t slot = 0; slot < N; slot++) {
+        slot_of[order[slot]] = slot;
+    }
+    return slot_of;
+}
+
+// Members in storage order; nesting adds no padding when alignments
+// decrease
+template <typename... Ts> struct Storage {
+    auto operator==(const Storage &) const -> bool = default;
+};
+template <typename T, typename... Ts> struct Storage<T, Ts...> {
+    T head{};
+    [[no_unique_address]] Storage<Ts...> tail{};
+
+    auto operator==(const Storage &) const -> bool = default;
+};
+
+template <std::size_t Slot, typename S>
+constexpr auto slot(S &storage) -> auto & {
+    if constexpr (Slot == 0) {
+        return storage.head;
+    } else {
+        return slot<Slot - 1>(storage.tail);
+    }
+}
+
+} // namespace detail
+
+template <typename... Ts> class PackedTuple {
+    using Types = std::tuple<Ts...>;
+    static constexpr auto order = detail::storage_order<Ts...>();
+    static constexpr auto slot_of = detail::inverse(order);
+
+    template <std::size_t... S>
+    static auto storage_type(std::index_sequence<S...>)
+        -> detail::Storage<std::tuple_element_t<order[S], Types>...>;
+    using Storage =
+        decltype(storage_type(std::make_index_sequence<sizeof...(Ts)>{}));
+
+    template <std::size_t... S>
+    static constexpr auto storage_layout(std::index_sequence<S...>) {
+        return layout_of<std::tuple_element_t<order[S], Types>...>();
+    }
+
+  public:
+    template <std::size_t I>
+    using element_type = std::tuple_element_t<I, Types>;
+
+    static constexpr std::size_t num_fields = sizeof...(Ts);
+    // Layout of the fields in storage order
+    static constexpr auto layout =
+        storage_layout(std::make_index_sequence<sizeof...(Ts)>{});
+    static_assert(sizeof(Storage) == layout.size);
+
+    constexpr PackedTuple() = default;
+
+    // One value per field, in declaration order
+    constexpr explicit PackedTuple(const Ts &...values)
+        requires(sizeof...(Ts) > 0)
+    {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ((get<I>() = values), ...);
+        }(std::make_index_sequence<sizeof...(Ts)>{});
+    }
+
+    template <std::size_t I> constexpr auto get() -> element_type<I> & {
+        return detail::slot<slot_of[I]>(storage_);
+    }
+    template <std::size_t I>
+    [[nodiscard]] constexpr auto get() const -> const element_type<I> & {
+        return detail::slot<slot_of[I]>(storage_);
+    }
+
+    // Byte offset of field `I` (declaration index)
+    template <std::size_t I> static constexpr auto offset() -> std::size_t {
+        return layout.members[slot_of[I]].offset;
+    }
+
+    auto operator==(const PackedTuple &) const -> bool = default;
+
+  private:
+    Storage storage_;
+};
+
+namespace detail {
+
+template <typename T, typename Indices> struct packed_of;
+template <typename T, std::size_t... I>
+struct packed_of<T, std::index_sequence<I...>> {
+    using type = PackedTuple<member_t<T, I>...>;
+};
+
+} // namespace detail
+
+// The members of aggregate `T`, packed
+template <aggregate T>
+using packed_t =
+    typename detail::packed_of<T,
+                               std::make_index_sequence<member_count<T>>>::type;
+
+template <aggregate T> constexpr auto pack(const T &value) -> packed_t<T> {
+    return std::apply(
+        [](const auto &...members) { return packed_t<T>{members...}; },
+        soa_vector::tie_members(value));
+}
+
+template <aggregate T>
+constexpr auto unpack(const packed_t<T> &packed) -> T {
+    return [&]<std::size_t... I>(std::index_sequence<I...>) {
+        return T{packed.template get<I>()...};
+    }(std::make_index_sequence<member_count<T>>{});
+}
+
+} // namespace struct_layout
+
+// Structured bindings: `auto [id, price] = packed` (declaration order)
+template <typename... Ts>
+struct std::tuple_size<struct_layout::PackedTuple<Ts...>>
+    : std::integral_constant<std::size_t, sizeof...(Ts)> {};
+
+template <std::size_t I, typename... Ts>
+struct std::tuple_element<I, struct_layout::PackedTuple<Ts...>> {
+    using type = std::tuple_element_t<I, std::tuple<Ts...>>;
+};
@@ -0,0 +1,74 @@
+#include <cmath>
+#include <cstddef>
+#include <print>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "summation/summation.hpp"
+
+using namespace std;
+
+constexpr size_t num_values = 20'000'000;
+constexpr int reps = 5;
+
+template <typename Sum>
+void run(const char *name, span<const float> values, long double expected,
+         Sum sum) {
+    float result = 0;
+    auto t = bench::time_best(reps, [&] {
+        result = sum(values);
+        bench::do_not_optimize(result);
+    });
+    auto error = std::abs(static_cast<long double>(result) - expected);
+    bench::report(name, t, num_values, "values");
+    println("  {:<36} result {:.1f}, abs error {:.3g}, rel error {:.3g}", "",
+            result, static_cast<double>(error),
+            static_cast<double>(error / expected));
+}
+
+void run_all(const char *label, const vector<float> &data) {
+    span<const float> values{data};
+    long double expected = 0;
+    for (float v : data) {
+        expected += v;
+    }
+    println("\n{} (exact sum {:.1f}):", label, static_cast<double>(expected));
+
+    run("scalar float accumulator", values, expected,
+        summation::scalar<float>);
+    run("scalar double accumulator", values, expected, [](auto v) {
+        double d = 0.0;
+        for (float x : v) {
+            d += x;
+        }
+        return static_cast<float>(d);
+    });
+    run("naive (per-lane)", values, expected, summation::naive<float>);
+    run("kahan", values, expected, summation::kahan<float>);
+    run("neumaier", values, expected, summation::neumaier<float>);
+    run("pairwise", values, expected, summation::pairwise<float>);
+}
+
+auto main() -> int {
+    println("Summation - compensated and pairwise float sums");
+    println("{} float values, {} SIMD lanes", num_values,
+            summation::simd_t<float>::size());
+
+    // the basic_concepts_ii case
+    run_all("1.0F, twenty million times", vector<float>(num_values, 1.0F));
+
+    mt19937 rng{5};
+    uniform_real_distribution<float> dist{0.0F, 1.0F};
+    vector<float> data(num_values);
+    for (auto &v : data) {
+        v = dist(rng);
+    }
+    run_all("uniform [0, 1)", data);
+
+    // one huge value up front, so every later addend is below the precision
+    // of the running sum
+    data[0] = 1e9F;
+    run_all("1e9 followed by uniform [0, 1)", data);
+}
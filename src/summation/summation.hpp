@@ -0,0 +1,167 @@
+#pragma once
+
+// Accurate float summation without switching storage to double
+//
+// basic_concepts_ii adds `1.0F` twenty million times and stops at 16777216:
+// past 2^24 the float spacing is 2, so `f + 1.0F` rounds back to `f`. Each
+// variant here keeps the data as `float` and trades a little arithmetic for
+// accuracy:
+//   - naive     - independent accumulators per SIMD lane (already better
+//                 than the single scalar accumulator: each one sees only a
+//                 fraction of the values)
+//   - kahan     - per-lane running compensation for the low-order bits lost
+//                 by each addition
+//   - neumaier  - Kahan's variant that stays correct when an addend is larger
+//                 than the running sum
+//   - pairwise  - recursive halving down to SIMD-summed blocks; error grows
+//                 with log(n) instead of n, at naive speed
+//
+// The compensated variants rely on IEEE evaluation order; they silently
+// degrade to naive under `-ffast-math` (`-fassociative-math`), which lets the
+// compiler simplify `(t - s) - y` to 0.
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <experimental/simd>
+#include <span>
+
+namespace summation {
+
+namespace stdx = std::experimental;
+
+template <std::floating_point T> using simd_t = stdx::native_simd<T>;
+
+// Plain scalar loop - the basic_concepts_ii version, for reference
+template <std::floating_point T> //
+auto scalar(std::span<const T> values) -> T {
+    T sum = 0;
+    for (T v : values) {
+        sum += v;
+    }
+    return sum;
+}
+
+// Independent accumulators per variant
+// - a float add has a latency of several cycles; one chain of dependent adds
+//   would leave the SIMD units idle between steps
+inline constexpr std::size_t chains = 4;
+
+template <std::floating_point T> //
+auto naive(std::span<const T> values) -> T {
+    constexpr std::size_t width = simd_t<T>::size();
+    std::array<simd_t<T>, chains> sum{};
+    std::size_t i = 0;
+    for (; i + (chains * width) <= values.size(); i += chains * width) {
+        for (std::size_t k = 0; k < chains; k++) {
+            sum[k] += simd_t<T>{values.data() + i + (k * width),
+                                stdx::element_aligned};
+        }
+    }
+    for (std::size_t k = 1; k < chains; k++) {
+        sum[0] += sum[k];
+    }
+    T total = stdx::reduce(sum[0]);
+    for (; i < values.size(); i++) {
+        total += values[i];
+    }
+    return total;
+}
+
+namespace detail {
+
+// Scalar Neumaier step, used to fold lanes and tails together
+template <std::floating_point T> //
+void neumaier_add(T &sum, T &compensation, T value) {
+    T t = sum + value;
+    if (std::abs(sum) >= std::abs(value)) {
+        compensation += (sum - t) + value;
+    } else {
+        compensation += (value - t) + sum;
+    }
+    sum = t;
+}
+
+// Fold per-lane sums and compensations (`sum + compensation` per lane) plus
+// a scalar tail into one result
+template <std::floating_point T>
+auto fold(const std::array<simd_t<T>, chains> &sum,
+          const std::array<simd_t<T>, chains> &compensation,
+          std::span<const T> tail) -> T {
+    T total = 0;
+    T c = 0;
+    for (std::size_t k = 0; k < chains; k++) {
+        for (std::size_t lane = 0; lane < simd_t<T>::size(); lane++) {
+            neumaier_add(total, c, T{sum[k][lane]});
+            neumaier_add(total, c, T{compensation[k][lane]});
+        }
+    }
+    for (T v : tail) {
+        neumaier_add(total, c, v);
+    }
+    return total + c;
+}
+
+} // namespace detail
+
+template <std::floating_point T> //
+auto kahan(std::span<const T> values) -> T {
+    constexpr std::size_t width = simd_t<T>::size();
+    std::array<simd_t<T>, chains> sum{};
+    // lost low-order part of `sum`, kept negated as in Kahan's formulation
+    std::array<simd_t<T>, chains> c{};
+    std::size_t i = 0;
+    for (; i + (chains * width) <= values.size(); i += chains * width) {
+        for (std::size_t k = 0; k < chains; k++) {
+            simd_t<T> y = simd_t<T>{values.data() + i + (k * width),
+                                    stdx::element_aligned} -
+                          c[k];
+            simd_t<T> t = sum[k] + y;
+            c[k] = (t - sum[k]) - y;
+            sum[k] = t;
+        }
+    }
+    for (auto &ck : c) {
+        ck = -ck;
+    }
+    return detail::fold<T>(sum, c, values.subspan(i));
+}
+
+template <std::floating_point T> //
+auto neumaier(std::span<const T> values) -> T {
+    constexpr std::size_t width = simd_t<T>::size();
+    std::array<simd_t<T>, chains> sum{};
+    std::array<simd_t<T>, chains> c{};
+    std::size_t i = 0;
+    for (; i + (chains * width) <= values.size(); i += chains * width) {
+        for (std::size_t k = 0; k < chains; k++) {
+            simd_t<T> v{values.data() + i + (k * width), stdx::element_aligned};
+            simd_t<T> t = sum[k] + v;
+            simd_t<T> lost = (sum[k] - t) + v;
+            where(stdx::abs(sum[k]) < stdx::abs(v), lost) = (v - t) + sum[k];
+            c[k] += lost;
+            sum[k] = t;
+        }
+    }
+    return detail::fold<T>(sum, c, values.subspan(i));
+}
+
+// Blocks at or below this size are summed with `naive`
+inline constexpr std::size_t pairwise_block = 256;
+
+template <std::floating_point T> //
+auto pairwise(std::span<const T> values) -> T {
+    if (values.size() <= pairwise_block) {
+        return naive(values);
+    }
+    // split on a block boundary so every leaf but the last is a full block
+    std::size_t half = values.size() / 2;
+    half -= half % pairwise_block;
+    if (half == 0) {
+        half = pairwise_block;
+    }
+    return pairwise(values.first(half)) + pairwise(values.subspan(half));
+}
+
+} // namespace summation
@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <print>
+#include <random>
+#include <span>
+#include <variant>
+#include <vector>
+
+#include "bench/bench.hpp"
+#include "tagged_union/tagged_union.hpp"
+
+using namespace std;
+
+#define PRINT_VAR(var) std::println("{} = {}", #var, var);
+
+constexpr size_t num_values = 10'000'000;
+constexpr int reps = 5;
+
+// 8 alternatives of plain data
+struct Circle {
+    float r;
+    [[nodiscard]] auto area() const -> float { return 3.14159F * r * r; }
+};
+struct Square {
+    float s;
+    [[nodiscard]] auto area() const -> float { return s * s; }
+};
+struct Rect {
+    float w, h;
+    [[nodiscard]] auto area() const -> float { return w * h; }
+};
+struct Triangle {
+    float b, h;
+    [[nodiscard]] auto area() const -> float { return 0.5F * b * h; }
+};
+struct Ellipse {
+    float a, b;
+    [[nodiscard]] auto area() const -> float { return 3.14159F * a * b; }
+};
+struct Ring {
+    float outer, inner;
+    [[nodiscard]] auto area() const -> float {
+        return 3.14159F * ((outer * outer) - (inner * inner));
+    }
+};
+struct Trapezoid {
+    float a, b, h;
+    [[nodiscard]] auto area() const -> float { return 0.5F * (a + b) * h; }
+};
+struct Rhombus {
+    float d1, d2;
+    [[nodiscard]] auto area() const -> float { return 0.5F * d1 * d2; }
+};
+
+using StdShape = variant<Circle, Square, Rect, Triangle, Ellipse, Ring,
+                         Trapezoid, Rhombus>;
+using Shape = tagged_union::TaggedUnion<Circle, Square, Rect, Triangle,
+                                        Ellipse, Ring, Trapezoid, Rhombus>;
+
+// The C-style alternative: a raw union and a tag kept next to it by hand
+struct RawShape {
+    uint8_t tag;
+    union {
+        Circle circle;
+        Square square;
+        Rect rect;
+        Triangle triangle;
+        Ellipse ellipse;
+        Ring ring;
+        Trapezoid trapezoid;
+        Rhombus rhombus;
+    };
+};
+
+// NOLINTBEGIN(cppcoreguidelines-pro-type-union-access)
+auto raw_area(const RawShape &s) -> float {
+    switch (s.tag) {
+    case 0:
+        return s.circle.area();
+    case 1:
+        return s.square.area();
+    case 2:
+        return s.rect.area();
+    case 3:
+        return s.triangle.area();
+    case 4:
+        return s.ellipse.area();
+    case 5:
+        return s.ring.area();
+    case 6:
+        return s.trapezoid.area();
+    default:
+        return s.rhombus.area();
+    }
+}
+// NOLINTEND(cppcoreguidelines-pro-type-union-access)
+
+constexpr auto area = [](const auto &shape) { return shape.area(); };
+
+// Same shapes in all three representations
+void make_shapes(vector<StdShape> &std_shapes, vector<Shape> &shapes,
+                 vector<RawShape> &raw_shapes) {
+    mt19937 rng{15};
+    uniform_real_distribution<float> dist{1, 2};
+    for (size_t i = 0; i < num_values; i++) {
+        auto kind = rng() % Shape::size;
+        auto a = dist(rng);
+        auto b = dist(rng) / 2;
+        tagged_union::dispatch<Shape::size>(kind, [&](auto k) {
+            constexpr size_t I = decltype(k)::value;
+            using T = Shape::alternative<I>;
+            T value{};
+            if constexpr (sizeof(T) == sizeof(float)) {
+                value = T{a};
+            } else if constexpr (sizeof(T) == 2 * sizeof(float)) {
+                value = T{a, b};
+            } else {
+                value = T{a, b, a};
+            }
+            std_shapes.emplace_back(in_place_index<I>, value);
+            shapes.emplace_back(in_place_index<I>, value);
+            RawShape raw{};
+            raw.tag = static_cast<uint8_t>(I);
+            std::memcpy(&raw.circle, &value, sizeof(T));
+            raw_shapes.push_back(raw);
+        });
+    }
+}
+
+auto main() -> int {
+    println("Tagged union - uint8_t tag, switch-table visitation");
+
+    // basic_concepts_iii: `union U { int x; char y; }`, with a tag
+    println("\nunion U {{ int x; char y; }} as a TaggedUnion:");
+    tagged_union::TaggedUnion<int, char> u = 'y';
+    auto holds_char = u.holds<char>();
+    PRINT_VAR(holds_char)
+    PRINT_VAR(u.get<char>())
+    try {
+        PRINT_VAR(u.get<int>())
+    } catch (const bad_variant_access &e) {
+        println("u.get<int>() threw {}", e.what());
+    }
+
+    auto sizeof_std_shape = sizeof(StdShape);
+    auto sizeof_shape = sizeof(Shape);
+    auto sizeof_raw_shape = sizeof(RawShape);
+    PRINT_VAR(sizeof_std_shape)
+    PRINT_VAR(sizeof_shape)
+    PRINT_VAR(sizeof_raw_shape)
+
+    vector<StdShape> std_shapes;
+    vector<Shape> shapes;
+    vector<RawShape> raw_shapes;
+    make_shapes(std_shapes, shapes, raw_shapes);
+    println("\n{} shapes, 8 alternatives, random order:", num_values);
+
+    auto run = [&](const char *label, auto &&fn) {
+        float total = 0;
+        auto t = bench::time_best(reps, [&] { total = fn(); });
+        bench::report(label, t, num_values, "visits");
+        return total;
+    };
+    auto std_total = run("std::visit", [&] {
+        float sum = 0;
+        for (const auto &s : std_shapes) {
+            sum += std::visit(area, s);
+        }
+        return sum;
+    });
+    auto raw_total = run("raw union + switch", [&] {
+        float sum = 0;
+        for (const auto &s : raw_shapes) {
+            sum += raw_area(s);
+        }
+        return sum;
+    });
+    auto total = run("tagged_union::visit", [&] {
+        float sum = 0;
+        for (const auto &s : shapes) {
+            sum += tagged_union::visit(area, s);
+        }
+        return sum;
+    });
+    println("  totals match: {}", std_total == total && raw_total == total);
+
+    println("\ngrouped by tag:");
+    auto t = bench::time_best(
+        1, [&] { tagged_union::sort_by_tag(span<Shape>{shapes}); });
+    bench::report("sort_by_tag (counting sort)", t, num_values, "values");
+    ranges::stable_sort(std_shapes, {}, &StdShape::index);
+    auto sorted_std_total = run("std::visit", [&] {
+        float sum = 0;
+        for (const auto &s : std_shapes) {
+            sum += std::visit(area, s);
+        }
+        return sum;
+    });
+    auto sorted_total = run("tagged_union::visit", [&] {
+        float sum = 0;
+        for (const auto &s : shapes) {
+            sum += tagged_union::visit(area, s);
+        }
+        return sum;
+    });
+    auto batched_total = run("tagged_union::visit_sorted", [&] {
+        float sum = 0;
+        tagged_union::visit_sorted([&](const auto &s) { sum += s.area(); },
+                                   span<const Shape>{shapes});
+        return sum;
+    });
+    println("  totals match: {}",
+            sorted_std_total == sorted_total && batched_total == sorted_total);
+}
@@ -0,0 +1,252 @@
+#pragma once
+
+// Compact tagged union with switch-table visitation
+//
+// A raw `union U { int x; char y; }` doesn't know which member is active;
+// `std::variant` does, but
+//   - its index type and layout are up to the library (and `std::visit` is
+//     a table of function pointers on some of them, which the optimizer
+//     can't inline through)
+//   - it supports non-trivial alternatives, with valueless-by-exception
+//     states and their checks on every visit
+//
+// `TaggedUnion<Ts...>` is the middle ground for plain data in hot loops:
+//   - alternatives must be trivially copyable (like raw union members), so
+//     the whole object is trivially copyable too
+//   - the discriminator is one `uint8_t` after the storage (up to 255
+//     alternatives)
+//   - `visit` expands to one `switch` over the tag with a `case` per
+//     alternative (16 cases per level), which compilers lower to a flat jump
+//     table with the visitor inlined into every case
+//   - `visit_sorted` visits an array grouped by tag (see `sort_by_tag`) one
+//     run at a time: one dispatch per run, then a tight loop over values of
+//     a known type
+//
+// Accessors follow `std::variant`: `get<T>`/`get<I>` throw
+// `std::bad_variant_access` on the wrong alternative, `get_if` returns null.
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace tagged_union {
+
+namespace detail {
+
+template <typename T, typename... Ts>
+constexpr auto index_of() -> std::size_t {
+    constexpr std::array<bool, sizeof...(Ts)> matches{std::same_as<T, Ts>...};
+    for (std::size_t i = 0; i < matches.size(); i++) {
+        if (matches[i]) {
+            return i;
+        }
+    }
+    return matches.size();
+}
+
+template <typename T, typename... Ts>
+inline constexpr bool occurs_once = (std::size_t{std::same_as<T, Ts>} + ...) ==
+                                    1;
+
+} // namespace detail
+
+template <typename... Ts>
+    requires(sizeof...(Ts) > 0 && sizeof...(Ts) <= 255 &&
+             (std::is_trivially_copyable_v<Ts> && ...))
+class TaggedUnion {
+  public:
+    static constexpr std::size_t size = sizeof...(Ts);
+
+    template <std::size_t I>
+    using alternative = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    template <typename T>
+    static constexpr std::size_t index_of = detail::index_of<T, Ts...>();
+
+    // Holds a value-initialized first alternative
+    TaggedUnion() { emplace<0>(); }
+
+    template <typename T>
+        requires detail::occurs_once<std::remove_cvref_t<T>, Ts...>
+    // NOLINTNEXTLINE(google-explicit-constructor) - like std::variant
+    TaggedUnion(T &&value) {
+        emplace<index_of<std::remove_cvref_t<T>>>(std::forward<T>(value));
+    }
+
+    template <std::size_t I, typename... Args>
+    explicit TaggedUnion(std::in_place_index_t<I>, Args &&...args) {
+        emplace<I>(std::forward<Args>(args)...);
+    }
+
+    template <std::size_t I, typename... Args>
+    auto emplace(Args &&...args) -> alternative<I> & {
+        // trivially destructible: the old value needs no cleanup
+        auto *p = std::construct_at(
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            reinterpret_cast<alternative<I> *>(storage_.data()),
+            std::forward<Args>(args)...);
+        tag_ = static_cast<std::uint8_t>(I);
+        return *p;
+    }
+
+    [[nodiscard]] constexpr auto index() const -> std::size_t { return tag_; }
+
+    template <typename T> [[nodiscard]] constexpr auto holds() const -> bool {
+        return tag_ == index_of<T>;
+    }
+
+    // Unchecked access: the caller knows `index() == I`
+    template <std::size_t I> auto get_unchecked() -> alternative<I> & {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return *std::launder(reinterpret_cast<alternative<I> *>(
+            storage_.data()));
+    }
+    template <std::size_t I>
+    auto get_unchecked() const -> const alternative<I> & {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return *std::launder(reinterpret_cast<const alternative<I> *>(
+            storage_.data()));
+    }
+
+    template <std::size_t I> auto get() -> alternative<I> & {
+        check(I);
+        return get_unchecked<I>();
+    }
+    template <std::size_t I> auto get() const -> const alternative<I> & {
+        check(I);
+        return get_unchecked<I>();
+    }
+    template <typename T> auto get() -> T & { return get<index_of<T>>(); }
+    template <typename T> auto get() const -> const T & {
+        return get<index_of<T>>();
+    }
+
+    template <typename T> auto get_if() -> T * {
+        return holds<T>() ? &get_unchecked<index_of<T>>() : nullptr;
+    }
+    template <typename T> auto get_if() const -> const T * {
+        return holds<T>() ? &get_unchecked<index_of<T>>() : nullptr;
+    }
+
+  private:
+    void check(std::size_t i) const {
+        if (tag_ != i) {
+            throw std::bad_variant_access{};
+        }
+    }
+
+    alignas(Ts...) std::array<std::byte, std::max({sizeof(Ts)...})> storage_;
+    std::uint8_t tag_ = 0;
+};
+
+namespace detail {
+
+template <typename U> struct union_size;
+template <typename... Ts>
+struct union_size<TaggedUnion<Ts...>>
+    : std::integral_constant<std::size_t, sizeof...(Ts)> {};
+
+} // namespace detail
+
+// Call `f(std::integral_constant<std::size_t, tag>{})` for a runtime
+// `tag < size`: a `switch` over 16 tags starting at `Base`, then the next 16;
+// the cases past `size` are never taken (and compiled out)
+#define TAGGED_UNION_CASE(K)                                                   \
+    case Base + (K):                                                           \
+        if constexpr (Base + (K) < size) {                                     \
+            return std::forward<F>(f)(                                         \
+                std::integral_constant<std::size_t, Base + (K)>{});            \
+        }                                                                      \
+        break;
+
+template <std::size_t size, std::size_t Base = 0, typename F>
+auto dispatch(std::size_t tag, F &&f) -> decltype(auto) {
+    switch (tag) {
+        TAGGED_UNION_CASE(0)
+        TAGGED_UNION_CASE(1)
+        TAGGED_UNION_CASE(2)
+        TAGGED_UNION_CASE(3)
+        TAGGED_UNION_CASE(4)
+        TAGGED_UNION_CASE(5)
+        TAGGED_UNION_CASE(6)
+        TAGGED_UNION_CASE(7)
+        TAGGED_UNION_CASE(8)
+        TAGGED_UNION_CASE(9)
+        TAGGED_UNION_CASE(10)
+        TAGGED_UNION_CASE(11)
+        TAGGED_UNION_CASE(12)
+        TAGGED_UNION_CASE(13)
+        TAGGED_UNION_CASE(14)
+        TAGGED_UNION_CASE(15)
+    default:
+        if constexpr (Base + 16 < size) {
+            return dispatch<size, Base + 16>(tag, std::forward<F>(f));
+        }
+        break;
+    }
+    // every tag is one of the cases above
+    std::unreachable();
+}
+
+#undef TAGGED_UNION_CASE
+
+template <typename U>
+concept tagged = requires { detail::union_size<U>::value; };
+
+// Call `f` with the active alternative; every alternative must give the
+// same result type (as with `std::visit`)
+template <typename F, typename U>
+    requires tagged<std::remove_cvref_t<U>>
+auto visit(F &&f, U &&u) -> decltype(auto) {
+    constexpr auto size = detail::union_size<std::remove_cvref_t<U>>::value;
+    return dispatch<size>(u.index(), [&](auto i) -> decltype(auto) {
+        constexpr std::size_t I = decltype(i)::value;
+        return std::forward<F>(f)(u.template get_unchecked<I>());
+    });
+}
+
+// Stable counting sort by tag, so `visit_sorted` sees one run per
+// alternative
+template <typename... Ts>
+void sort_by_tag(std::span<TaggedUnion<Ts...>> values) {
+    std::array<std::size_t, sizeof...(Ts) + 1> starts{};
+    for (const auto &v : values) {
+        starts[v.index() + 1]++;
+    }
+    for (std::size_t i = 1; i < starts.size(); i++) {
+        starts[i] += starts[i - 1];
+    }
+    std::vector<TaggedUnion<Ts...>> sorted(values.size());
+    for (const auto &v : values) {
+        sorted[starts[v.index()]++] = v;
+    }
+    std::ranges::copy(sorted, values.begin());
+}
+
+// Call `f` on every element of `values`, grouped by tag (ex. by
+// `sort_by_tag`): each run of equal tags is dispatched once, and its loop
+// calls `f` on a statically known alternative until the tag changes
+template <typename F, typename... Ts>
+void visit_sorted(F &&f, std::span<const TaggedUnion<Ts...>> values) {
+    std::size_t k = 0;
+    while (k < values.size()) {
+        dispatch<sizeof...(Ts)>(values[k].index(), [&](auto i) {
+            constexpr std::size_t I = decltype(i)::value;
+            do {
+                f(values[k].template get_unchecked<I>());
+                k++;
+            } while (k < values.size() && values[k].index() == I);
+        });
+    }
+}
+
+} // namespace tagged_union